@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+    corpus.cpp
+    Created: 19 Oct 2026 9:58:20am
+    Author:  Aaron Cendan
+    Description: Reproducible synthetic audio corpus for benchmarking
+
+  ==============================================================================
+*/
+
+#include "corpus.h"
+
+using namespace zero::bench;
+
+namespace
+{
+	constexpr auto s_blockSize{ 8192 };
+	constexpr double s_sampleRates[]{ 44100.0, 48000.0, 96000.0 };
+	constexpr int s_channelCounts[]{ 1, 2, 2, 4, 6 };
+	constexpr int s_wavBitDepths[]{ 16, 24, 32 };
+	constexpr int s_flacBitDepths[]{ 16, 24 };
+
+	template<typename T, size_t N>
+	T pick(juce::Random& random, const T (& values)[N])
+	{
+		return values[static_cast<size_t>(random.nextInt(static_cast<int>(N)))];
+	}
+
+	auto createWriter(const juce::File& file, juce::OutputStream* stream, const CorpusFile& corpusFile)
+			-> std::unique_ptr<juce::AudioFormatWriter>
+	{
+		auto makeWriter = [&](auto& format)
+		{
+			return std::unique_ptr<juce::AudioFormatWriter>{ format.createWriterFor(
+					stream, corpusFile.m_sampleRate, static_cast<unsigned int>(corpusFile.m_numChannels),
+					corpusFile.m_bitDepth, {}, 0) };
+		};
+
+		if (file.hasFileExtension("wav"))
+		{
+			juce::WavAudioFormat format;
+			return makeWriter(format);
+		}
+
+		juce::FlacAudioFormat format;
+		return makeWriter(format);
+	}
+}
+
+Corpus::Corpus(juce::int64 seed, int numFiles, double maxLengthSeconds) :
+		m_seed{ seed }, m_numFiles{ numFiles }, m_maxLengthSeconds{ maxLengthSeconds }
+{
+	m_directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+			.getChildFile("zerobench-" + juce::String(m_seed));
+}
+
+Corpus::~Corpus()
+{
+	if (!m_keep)
+	{
+		m_directory.deleteRecursively();
+	}
+}
+
+bool Corpus::generate()
+{
+	m_directory.deleteRecursively();
+	if (!m_directory.createDirectory())
+	{
+		return false;
+	}
+
+	// Every property is drawn from the seeded generator, so identical seeds give identical corpora
+	juce::Random random{ m_seed };
+	m_files.clear();
+	m_files.reserve(static_cast<size_t>(m_numFiles));
+
+	for (auto i{ 0 }; i < m_numFiles; ++i)
+	{
+		CorpusFile corpusFile{};
+		const auto isFlac{ random.nextBool() };
+		corpusFile.m_numChannels = pick(random, s_channelCounts);
+		corpusFile.m_bitDepth = isFlac ? pick(random, s_flacBitDepths) : pick(random, s_wavBitDepths);
+		corpusFile.m_sampleRate = pick(random, s_sampleRates);
+
+		// Log-distributed lengths, so short one-shots and long ambiences are both represented
+		const auto minLength{ 0.05 };
+		const auto lengthSeconds{ minLength * std::pow(juce::jmax(m_maxLengthSeconds, minLength) / minLength,
+		                                               random.nextDouble()) };
+		corpusFile.m_numSamples = juce::jmax(static_cast<juce::int64>(lengthSeconds * corpusFile.m_sampleRate),
+		                                     static_cast<juce::int64>(1));
+		corpusFile.m_leadingSilence = static_cast<juce::int64>(
+				static_cast<double>(corpusFile.m_numSamples) * random.nextDouble() * 0.3);
+		corpusFile.m_trailingSilence = static_cast<juce::int64>(
+				static_cast<double>(corpusFile.m_numSamples) * random.nextDouble() * 0.3);
+		corpusFile.m_isMonoContent = corpusFile.m_numChannels > 1 && random.nextBool();
+
+		const auto name{ juce::String(i).paddedLeft('0', 5) + "_" + juce::String(corpusFile.m_numChannels) + "ch_" +
+		                 juce::String(corpusFile.m_bitDepth) + "bit" + (isFlac ? ".flac" : ".wav") };
+		corpusFile.m_file = m_directory.getChildFile(name);
+
+		if (!writeFile(corpusFile, random))
+		{
+			return false;
+		}
+		m_files.emplace_back(std::move(corpusFile));
+	}
+
+	return true;
+}
+
+bool Corpus::writeFile(CorpusFile& corpusFile, juce::Random& random) const
+{
+	auto stream{ std::make_unique<juce::FileOutputStream>(corpusFile.m_file) };
+	if (stream->failedToOpen())
+	{
+		return false;
+	}
+
+	auto writer{ createWriter(corpusFile.m_file, stream.get(), corpusFile) };
+	if (writer == nullptr)
+	{
+		return false;
+	}
+	stream.release(); // Writer owns stream now
+
+	const auto frequency{ 50.0 + random.nextDouble() * 2000.0 };
+	const auto noiseLevel{ random.nextFloat() * 0.2f };
+	const auto soundEnd{ corpusFile.m_numSamples - corpusFile.m_trailingSilence };
+	const auto phaseIncr{ juce::MathConstants<double>::twoPi * frequency / corpusFile.m_sampleRate };
+
+	juce::AudioBuffer<float> buffer{ corpusFile.m_numChannels, s_blockSize };
+	for (juce::int64 blockStart{ 0 }; blockStart < corpusFile.m_numSamples; blockStart += s_blockSize)
+	{
+		const auto numThisTime{ static_cast<int>(juce::jmin(corpusFile.m_numSamples - blockStart,
+		                                                    static_cast<juce::int64>(s_blockSize))) };
+		buffer.clear();
+
+		for (auto sample{ 0 }; sample < numThisTime; ++sample)
+		{
+			const auto pos{ blockStart + sample };
+			if (pos < corpusFile.m_leadingSilence || pos >= soundEnd)
+			{
+				continue;
+			}
+
+			const auto tone{ static_cast<float>(std::sin(phaseIncr * static_cast<double>(pos))) * 0.5f };
+			for (auto channel{ 0 }; channel < corpusFile.m_numChannels; ++channel)
+			{
+				const auto useSharedContent{ corpusFile.m_isMonoContent || channel == 0 };
+				const auto noise{ (random.nextFloat() * 2.0f - 1.0f) * noiseLevel };
+				buffer.setSample(channel, sample, useSharedContent ? tone : tone * 0.5f + noise);
+			}
+		}
+
+		if (!writer->writeFromAudioSampleBuffer(buffer, 0, numThisTime))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+juce::int64 Corpus::totalSamples() const
+{
+	juce::int64 total{ 0 };
+	for (const auto& corpusFile : m_files)
+	{
+		total += corpusFile.m_numSamples * corpusFile.m_numChannels;
+	}
+	return total;
+}
+
+juce::int64 Corpus::totalBytes() const
+{
+	juce::int64 total{ 0 };
+	for (const auto& corpusFile : m_files)
+	{
+		total += corpusFile.m_file.getSize();
+	}
+	return total;
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    corpus.h
+    Created: 19 Oct 2026 9:58:12am
+    Author:  Aaron Cendan
+    Description: Reproducible synthetic audio corpus for benchmarking
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace zero::bench
+{
+	struct CorpusFile
+	{
+		juce::File m_file{};
+		int m_numChannels{ 0 };
+		int m_bitDepth{ 0 };
+		double m_sampleRate{ 0.0 };
+		juce::int64 m_numSamples{ 0 };
+		juce::int64 m_leadingSilence{ 0 };
+		juce::int64 m_trailingSilence{ 0 };
+		bool m_isMonoContent{ false };
+	};
+
+	class Corpus
+	{
+	public:
+		Corpus(juce::int64 seed, int numFiles, double maxLengthSeconds);
+		~Corpus();
+
+		bool generate();
+
+		const std::vector<CorpusFile>& files() const { return m_files; }
+		const juce::File& directory() const { return m_directory; }
+
+		juce::int64 totalSamples() const;
+		juce::int64 totalBytes() const;
+
+		void keepOnDisk(bool keep) { m_keep = keep; }
+
+	private:
+		bool writeFile(CorpusFile& corpusFile, juce::Random& random) const;
+
+		juce::int64 m_seed{ 0 };
+		int m_numFiles{ 0 };
+		double m_maxLengthSeconds{ 0.0 };
+		bool m_keep{ false };
+
+		juce::File m_directory{};
+		std::vector<CorpusFile> m_files{};
+	};
+}
@@ -0,0 +1,281 @@
+/*
+  ==============================================================================
+
+    main.cpp
+    Created: 19 Oct 2026 9:58:31am
+    Author:  Aaron Cendan
+    Description: Benchmark suite for zerochecker analysis kernels
+
+  ==============================================================================
+*/
+
+#include "corpus.h"
+#include "../../Source/zerochecker.h"
+#include "../../Source/literals.h"
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_helpText{ R"(zerobench - benchmark suite for zerochecker
+
+USAGE:
+    zerobench [--seed=1] [--files=64] [--length=20] [--iterations=5] [--out=results.json] [--keep]
+
+    --seed        Seed for the synthetic corpus. Identical seeds generate identical corpora.
+    --files       Number of files to generate.
+    --length      Maximum file length in seconds (lengths are log-distributed).
+    --iterations  Number of timed runs per kernel. The median run is reported.
+    --out         Write JSON results to file instead of stdout.
+    --keep        Keep the generated corpus on disk after finishing.
+)" };
+
+	struct Throughput
+	{
+		juce::String m_name{};
+		std::vector<double> m_seconds{};
+		juce::int64 m_numFiles{ 0 };
+		juce::int64 m_numSamples{ 0 };
+		juce::int64 m_numBytes{ 0 };
+	};
+
+	double median(std::vector<double> values)
+	{
+		if (values.empty())
+		{
+			return 0.0;
+		}
+		std::sort(values.begin(), values.end());
+		return values[values.size() / 2];
+	}
+
+	template<typename Function>
+	Throughput measure(const juce::String& name, int iterations, Function&& function)
+	{
+		Throughput result{ name };
+		for (auto i{ 0 }; i < iterations; ++i)
+		{
+			const auto start{ juce::Time::getHighResolutionTicks() };
+			function();
+			const auto end{ juce::Time::getHighResolutionTicks() };
+			result.m_seconds.push_back(juce::Time::highResolutionTicksToSeconds(end - start));
+		}
+		return result;
+	}
+
+	// Samples (across channels) a zero search decodes: forward up to the first non-zero and back from the end to the
+	// last, so only files without any non-zero are read in full, and digital silence isn't decoded at all
+	Throughput& countSearchedSamples(Throughput& result, const zero::File& file, const juce::AudioFormatReader& reader)
+	{
+		const auto length{ reader.lengthInSamples };
+		const auto forward{ (file.m_firstNonZeroSample >= 0) ? file.m_firstNonZeroSample + 1 : length };
+		const auto reverse{ (file.m_lastNonZeroSample >= 0) ? file.m_lastNonZeroSample + 1 : length };
+		const auto numSamples{ file.m_isDigitalSilence ? 0 : (forward + reverse) * reader.numChannels };
+		result.m_numSamples += numSamples;
+		result.m_numBytes += numSamples * reader.bitsPerSample / 8;
+		return result;
+	}
+
+	juce::var toVar(const Throughput& result)
+	{
+		const auto seconds{ median(result.m_seconds) };
+		const auto perSecond = [seconds](double value)
+		{
+			return seconds > 0.0 ? value / seconds : 0.0;
+		};
+
+		auto* obj{ new juce::DynamicObject() };
+		obj->setProperty("name", result.m_name);
+		obj->setProperty("iterations", static_cast<int>(result.m_seconds.size()));
+		obj->setProperty("medianSeconds", seconds);
+		obj->setProperty("minSeconds", *std::min_element(result.m_seconds.begin(), result.m_seconds.end()));
+		obj->setProperty("files", result.m_numFiles);
+		obj->setProperty("samples", result.m_numSamples);
+		obj->setProperty("bytes", result.m_numBytes);
+		obj->setProperty("samplesPerSecond", perSecond(static_cast<double>(result.m_numSamples)));
+		obj->setProperty("filesPerSecond", perSecond(static_cast<double>(result.m_numFiles)));
+		obj->setProperty("megabytesPerSecond", perSecond(static_cast<double>(result.m_numBytes) / (1024.0 * 1024.0)));
+		return obj;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const juce::ArgumentList args{ argc, argv };
+	if (args.containsOption("-h|--help"))
+	{
+		std::cout << s_helpText;
+		return 0;
+	}
+
+	const auto optionOr = [&args](juce::StringRef option, const juce::String& fallback)
+	{
+		return args.containsOption(option) ? args.getValueForOption(option) : fallback;
+	};
+
+	const auto seed{ optionOr("--seed", "1").getLargeIntValue() };
+	const auto numFiles{ juce::jmax(1, optionOr("--files", "64").getIntValue()) };
+	const auto maxLength{ juce::jmax(0.05, optionOr("--length", "20").getDoubleValue()) };
+	const auto iterations{ juce::jmax(1, optionOr("--iterations", "5").getIntValue()) };
+
+	bench::Corpus corpus{ seed, numFiles, maxLength };
+	corpus.keepOnDisk(args.containsOption("--keep"));
+	if (!corpus.generate())
+	{
+		std::cerr << "Failed to generate corpus in " << corpus.directory().getFullPathName() << ltrl::endl;
+		return 1;
+	}
+
+	juce::AudioFormatManager formatMngr{};
+	formatMngr.registerBasicFormats();
+
+	// Kernels are timed with readers already open, so only the analysis itself is measured
+	std::vector<std::unique_ptr<juce::AudioFormatReader>> readers{};
+	std::vector<zero::File> files{};
+	juce::int64 multichannelSamples{ 0 };
+	juce::int64 multichannelBytes{ 0 };
+	juce::int64 numMultichannelFiles{ 0 };
+	for (const auto& corpusFile : corpus.files())
+	{
+		readers.emplace_back(formatMngr.createReaderFor(corpusFile.m_file));
+		files.emplace_back(corpusFile.m_file);
+		if (readers.back() == nullptr)
+		{
+			std::cerr << "Failed to open " << corpusFile.m_file.getFullPathName() << ltrl::endl;
+			return 1;
+		}
+		if (corpusFile.m_numChannels > 1)
+		{
+			++numMultichannelFiles;
+			multichannelSamples += corpusFile.m_numSamples * corpusFile.m_numChannels;
+			multichannelBytes += corpusFile.m_file.getSize();
+		}
+	}
+
+	Checker defaults{};
+	std::vector<Throughput> results{};
+
+	auto searchForLevel{ measure("searchForLevel", iterations, [&]
+	{
+		for (size_t i{ 0 }; i < files.size(); ++i)
+		{
+			files[i].calculate(readers[i].get(), defaults.m_sampleOffset.val, defaults.m_numSamplesToSearch.val,
+			                   defaults.m_magnitudeRangeMin.val, defaults.m_magnitudeRangeMax.val,
+			                   defaults.m_minConsecutiveSamples.val);
+		}
+	}) };
+	searchForLevel.m_numFiles = static_cast<juce::int64>(files.size());
+	for (size_t i{ 0 }; i < files.size(); ++i)
+	{
+		countSearchedSamples(searchForLevel, files[i], *readers[i]);
+	}
+	results.emplace_back(std::move(searchForLevel));
+
+	auto monoCompatibility{ measure("calculateMonoCompatibility", iterations, [&]
+	{
+		for (size_t i{ 0 }; i < files.size(); ++i)
+		{
+			if (readers[i]->numChannels > 1)
+			{
+				files[i] = zero::File{ files[i].m_file };
+				files[i].calculateMonoCompatibility(readers[i].get(), defaults.m_sampleOffset.val,
+				                                    defaults.m_numSamplesToSearch.val);
+			}
+		}
+	}) };
+	monoCompatibility.m_numFiles = numMultichannelFiles;
+	monoCompatibility.m_numSamples = multichannelSamples;
+	monoCompatibility.m_numBytes = multichannelBytes;
+	results.emplace_back(std::move(monoCompatibility));
+	readers.clear();
+
+	// End-to-end runs go through Checker::for_each, including reader creation and header parsing
+	const auto endToEnd = [&](const juce::String& name, std::function<void(zero::File&)> function) -> Throughput&
+	{
+		Checker checker{};
+		auto result{ measure(name, iterations, [&]
+		{
+			checker.m_files.val.clear();
+			for (const auto& corpusFile : corpus.files())
+			{
+				checker.m_files.val.emplace_back(corpusFile.m_file);
+			}
+			checker.for_each(function);
+		}) };
+		result.m_numFiles = static_cast<juce::int64>(corpus.files().size());
+		result.m_numSamples = corpus.totalSamples();
+		result.m_numBytes = corpus.totalBytes();
+		return results.emplace_back(std::move(result));
+	};
+
+	// Every run searches the same samples, so the total is averaged over the runs
+	std::mutex searchedMutex{};
+	Throughput searched{};
+	auto& zerochecker{ endToEnd("for_each.zerochecker", [&](zero::File& zeroFile)
+	{
+		if (auto reader = std::unique_ptr<juce::AudioFormatReader>(formatMngr.createReaderFor(zeroFile.m_file)))
+		{
+			zeroFile.calculate(reader.get(), defaults.m_sampleOffset.val, defaults.m_numSamplesToSearch.val,
+			                   defaults.m_magnitudeRangeMin.val, defaults.m_magnitudeRangeMax.val,
+			                   defaults.m_minConsecutiveSamples.val);
+
+			std::scoped_lock lock{ searchedMutex };
+			countSearchedSamples(searched, zeroFile, *reader);
+		}
+	}) };
+	zerochecker.m_numSamples = searched.m_numSamples / iterations;
+	zerochecker.m_numBytes = searched.m_numBytes / iterations;
+
+	endToEnd("for_each.monochecker", [&](zero::File& zeroFile)
+	{
+		if (auto reader = std::unique_ptr<juce::AudioFormatReader>(formatMngr.createReaderFor(zeroFile.m_file)))
+		{
+			zeroFile.calculateMonoCompatibility(reader.get(), defaults.m_sampleOffset.val,
+			                                    defaults.m_numSamplesToSearch.val);
+		}
+	});
+
+	// Machine-readable report
+	auto* corpusObj{ new juce::DynamicObject() };
+	corpusObj->setProperty("seed", seed);
+	corpusObj->setProperty("files", static_cast<int>(corpus.files().size()));
+	corpusObj->setProperty("samples", corpus.totalSamples());
+	corpusObj->setProperty("bytes", corpus.totalBytes());
+	corpusObj->setProperty("maxLengthSeconds", maxLength);
+
+	auto* systemObj{ new juce::DynamicObject() };
+	systemObj->setProperty("os", juce::SystemStats::getOperatingSystemName());
+	systemObj->setProperty("cpu", juce::SystemStats::getCpuModel());
+	systemObj->setProperty("numCpus", juce::SystemStats::getNumCpus());
+
+	juce::Array<juce::var> kernels{};
+	for (const auto& result : results)
+	{
+		kernels.add(toVar(result));
+	}
+
+	auto* report{ new juce::DynamicObject() };
+	report->setProperty("benchmark", "zerochecker");
+	report->setProperty("version", ProjectInfo::versionString);
+	report->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+	report->setProperty("corpus", corpusObj);
+	report->setProperty("system", systemObj);
+	report->setProperty("results", kernels);
+
+	const auto json{ juce::JSON::toString(juce::var{ report }) };
+	if (args.containsOption("--out"))
+	{
+		const auto outFile{ args.getFileForOption("--out") };
+		if (!outFile.replaceWithText(json))
+		{
+			std::cerr << "Failed to write " << outFile.getFullPathName() << ltrl::endl;
+			return 1;
+		}
+	}
+	else
+	{
+		std::cout << json << ltrl::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,236 @@
+/*
+  ==============================================================================
+
+    libzerochecker.cpp
+    Created: 19 Oct 2026 8:34:51pm
+    Author:  Aaron Cendan
+    Description: Embeddable zerochecker/monochecker API for readers, memory blocks and sample spans
+
+  ==============================================================================
+*/
+
+#include "libzerochecker.h"
+#include "../../Source/analysis.h"
+#include "../../Source/file.h"
+#include "../../Source/w64.h"
+
+#include <atomic>
+
+using namespace zero;
+
+namespace
+{
+	// Same formats as the console, registered once and shared by every thread; lookups don't mutate the manager
+	juce::AudioFormatManager& getFormatManager()
+	{
+		static auto* const manager = []
+		{
+			auto* formatMngr{ new juce::AudioFormatManager() };
+			formatMngr->registerBasicFormats();
+			formatMngr->registerFormat(new W64AudioFormat(), false);
+			return formatMngr;
+		}();
+		return *manager;
+	}
+
+	juce::ThreadPool& getSharedPool()
+	{
+		static juce::ThreadPool pool{ juce::SystemStats::getNumCpus() };
+		return pool;
+	}
+
+	// Presents caller-owned interleaved floats as a reader, so spans go through the same analyzers as files
+	class SampleSpanReader : public juce::AudioFormatReader
+	{
+	public:
+		explicit SampleSpanReader(const lib::SampleSpan& samples) :
+				juce::AudioFormatReader{ nullptr, "Sample span" }, m_samples{ samples.m_samples }
+		{
+			sampleRate = samples.m_sampleRate;
+			numChannels = static_cast<unsigned int>(std::max(samples.m_numChannels, 0));
+			bitsPerSample = 32;
+			usesFloatingPointData = true;
+			lengthInSamples = (numChannels > 0) ? static_cast<juce::int64>(m_samples.size() / numChannels) : 0;
+		}
+
+		bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+		                 juce::int64 startSampleInFile, int numSamples) override
+		{
+			clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+			                                  startSampleInFile, numSamples, lengthInSamples);
+
+			const auto stride{ static_cast<size_t>(numChannels) };
+			for (auto ch{ 0 }; ch < numDestChannels; ++ch)
+			{
+				if (destChannels[ch] == nullptr || ch >= static_cast<int>(numChannels))
+				{
+					continue;
+				}
+
+				auto* dest{ reinterpret_cast<float*>(destChannels[ch]) + startOffsetInDestBuffer };
+				const auto* src{ m_samples.data() + static_cast<size_t>(startSampleInFile) * stride +
+				                 static_cast<size_t>(ch) };
+				for (auto i{ 0 }; i < numSamples; ++i)
+				{
+					dest[i] = src[static_cast<size_t>(i) * stride];
+				}
+			}
+			return true;
+		}
+
+	private:
+		std::span<const float> m_samples{};
+	};
+
+	// Combined analyses share a single decode pass over the whole search window
+	void analyzeInOnePass(juce::AudioFormatReader& reader, const lib::Options& options, File& zeroFile)
+	{
+		std::vector<std::unique_ptr<Analyzer>> analyzers{};
+		if (options.m_analyses & lib::Analysis::ZERO)
+		{
+			analyzers.emplace_back(std::make_unique<ZeroAnalyzer>(options.m_magnitudeRangeMin,
+			                                                      options.m_magnitudeRangeMax,
+			                                                      options.m_minConsecutiveSamples));
+		}
+		if (options.m_analyses & lib::Analysis::MONO)
+		{
+			analyzers.emplace_back(std::make_unique<MonoAnalyzer>());
+		}
+		if (options.m_analyses & lib::Analysis::LEVEL)
+		{
+			analyzers.emplace_back(std::make_unique<LevelAnalyzer>());
+		}
+
+		zeroFile.analyze(&reader, options.m_startSampleOffset, options.m_numSamplesToSearch, analyzers);
+	}
+
+	lib::Result invalidResult(const juce::String& name)
+	{
+		lib::Result result{};
+		result.m_name = name;
+		return result;
+	}
+}
+
+lib::Result lib::analyze(juce::AudioFormatReader& reader, const Options& options)
+{
+	// Analyzers only ever write into a File, which carries no path for in-memory inputs
+	File zeroFile{ juce::File() };
+
+	// On its own, zerochecking stops reading at the first non-zero from each end instead of decoding everything
+	if (options.m_analyses == Analysis::ZERO)
+	{
+		zeroFile.calculate(&reader, options.m_startSampleOffset, options.m_numSamplesToSearch,
+		                   options.m_magnitudeRangeMin, options.m_magnitudeRangeMax, options.m_minConsecutiveSamples);
+	}
+	else
+	{
+		analyzeInOnePass(reader, options, zeroFile);
+	}
+
+	Result result{};
+	result.m_valid = true;
+	result.m_sampleRate = reader.sampleRate;
+	result.m_numChannels = static_cast<int>(reader.numChannels);
+	result.m_lengthInSamples = reader.lengthInSamples;
+	if (options.m_analyses & Analysis::ZERO)
+	{
+		result.m_firstNonZeroSample = zeroFile.m_firstNonZeroSample;
+		result.m_lastNonZeroSample = zeroFile.m_lastNonZeroSample;
+	}
+	if (options.m_analyses & Analysis::MONO)
+	{
+		result.m_monoCompatibility = zeroFile.m_monoCompatibility;
+	}
+	if (options.m_analyses & Analysis::LEVEL)
+	{
+		result.m_peak = zeroFile.m_peak;
+		result.m_rms = zeroFile.m_rms;
+		result.m_dcOffset = zeroFile.m_dcOffset;
+		result.m_numClippedSamples = zeroFile.m_numClippedSamples;
+	}
+	return result;
+}
+
+lib::Result lib::analyze(const juce::File& file, const Options& options)
+{
+	std::unique_ptr<juce::AudioFormatReader> reader{ getFormatManager().createReaderFor(file) };
+	if (reader == nullptr)
+	{
+		return invalidResult(file.getFullPathName());
+	}
+
+	auto result{ analyze(*reader, options) };
+	result.m_name = file.getFullPathName();
+	return result;
+}
+
+lib::Result lib::analyze(const juce::MemoryBlock& data, const Options& options)
+{
+	// The stream refers to the block rather than copying it
+	std::unique_ptr<juce::AudioFormatReader> reader{ getFormatManager().createReaderFor(
+			std::make_unique<juce::MemoryInputStream>(data, false)) };
+	if (reader == nullptr)
+	{
+		return invalidResult({});
+	}
+	return analyze(*reader, options);
+}
+
+lib::Result lib::analyze(const SampleSpan& samples, const Options& options)
+{
+	if (samples.m_numChannels <= 0 || samples.m_sampleRate <= 0.0)
+	{
+		return invalidResult({});
+	}
+
+	SampleSpanReader reader{ samples };
+	return analyze(reader, options);
+}
+
+std::vector<lib::Result> lib::analyze(const std::vector<Input>& inputs, const Options& options)
+{
+	std::vector<Result> results(inputs.size());
+	if (inputs.empty())
+	{
+		return results;
+	}
+
+	auto analyzeInput = [&](size_t index)
+	{
+		const auto& input{ inputs[index] };
+		results[index] = std::visit([&](const auto& source) { return analyze(source, options); }, input.m_source);
+		if (input.m_name.isNotEmpty())
+		{
+			results[index].m_name = input.m_name;
+		}
+	};
+
+	// Waiting on the pool from one of its own jobs could leave no thread free to run the batch, so run it in place
+	if (juce::ThreadPoolJob::getCurrentThreadPoolJob() != nullptr)
+	{
+		for (size_t index{ 0 }; index < inputs.size(); ++index)
+		{
+			analyzeInput(index);
+		}
+		return results;
+	}
+
+	// Each job writes only its own slot; the last one to finish wakes the caller
+	std::atomic<size_t> numRemaining{ inputs.size() };
+	juce::WaitableEvent finished{};
+	for (size_t index{ 0 }; index < inputs.size(); ++index)
+	{
+		getSharedPool().addJob([&, index]
+		{
+			analyzeInput(index);
+			if (numRemaining.fetch_sub(1) == 1)
+			{
+				finished.signal();
+			}
+		});
+	}
+
+	finished.wait();
+	return results;
+}
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    libzerochecker.h
+    Created: 19 Oct 2026 8:34:51pm
+    Author:  Aaron Cendan
+    Description: Embeddable zerochecker/monochecker API for readers, memory blocks and sample spans
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <span>
+#include <variant>
+
+namespace zero::lib
+{
+	// Analyses combined into a single decode pass, matching --analyze
+	enum Analysis
+	{
+		ZERO = 1 << 0, MONO = 1 << 1, LEVEL = 1 << 2
+	};
+
+	// Same meaning and defaults as the console's --offset, --num, --min, --max and --consec
+	struct Options
+	{
+		int m_analyses{ ZERO };
+		juce::int64 m_startSampleOffset{ 0 };
+		juce::int64 m_numSamplesToSearch{ -1 };
+		double m_magnitudeRangeMin{ 0.003 };
+		double m_magnitudeRangeMax{ 1.0 };
+		int m_minConsecutiveSamples{ 0 };
+	};
+
+	struct Result
+	{
+		juce::String m_name{};
+		bool m_valid{ false };  // False if the input couldn't be decoded
+		double m_sampleRate{ 0.0 };
+		int m_numChannels{ 0 };
+		juce::int64 m_lengthInSamples{ 0 };
+
+		// ZERO
+		juce::int64 m_firstNonZeroSample{ -1 };
+		juce::int64 m_lastNonZeroSample{ -1 };  // Counted back from the end, as in the console output
+
+		// MONO; -1 for mono inputs
+		float m_monoCompatibility{ -1.0f };
+
+		// LEVEL
+		float m_peak{ 0.0f };
+		float m_rms{ 0.0f };
+		float m_dcOffset{ 0.0f };
+		juce::int64 m_numClippedSamples{ 0 };
+	};
+
+	// Interleaved float samples owned by the caller, e.g. a render buffer straight out of an export
+	struct SampleSpan
+	{
+		std::span<const float> m_samples{};
+		int m_numChannels{ 1 };
+		double m_sampleRate{ 48000.0 };
+	};
+
+	// One batch entry: a file on disk, an encoded file held in memory, or raw interleaved samples
+	struct Input
+	{
+		juce::String m_name{};
+		std::variant<juce::File, juce::MemoryBlock, SampleSpan> m_source{};
+	};
+
+	Result analyze(juce::AudioFormatReader& reader, const Options& options);
+	Result analyze(const juce::File& file, const Options& options);
+	Result analyze(const juce::MemoryBlock& data, const Options& options);
+	Result analyze(const SampleSpan& samples, const Options& options);
+
+	// Runs every input on a thread pool shared by all callers, returning results in input order. Sample spans and
+	// memory blocks must stay alive until the call returns. Called from inside a juce::ThreadPool job, the batch runs
+	// serially on the calling thread instead.
+	std::vector<Result> analyze(const std::vector<Input>& inputs, const Options& options);
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    alignment.cpp
+    Created: 19 Oct 2026 2:12:48pm
+    Author:  Aaron Cendan
+    Description: Relative offsets within groups of synchronized assets via FFT cross-correlation
+
+  ==============================================================================
+*/
+
+#include "alignment.h"
+#include "profiler.h"
+
+#include <complex>
+#include <regex>
+
+using namespace zero;
+
+FileGroups zero::groupFiles(std::vector<File>& files, const juce::String& pattern)
+{
+	FileGroups groups{};
+	if (pattern.isEmpty() || pattern.equalsIgnoreCase("folder"))
+	{
+		for (auto& file : files)
+		{
+			groups[file.m_file.getParentDirectory().getFullPathName()].push_back(&file);
+		}
+		return groups;
+	}
+
+	// Strip the pattern from the name, so e.g. "_(en|fr|de)$" groups vo_001_en and vo_001_fr together
+	const std::regex regex{ pattern.toStdString(), std::regex::icase };
+	for (auto& file : files)
+	{
+		const auto name{ file.m_file.getFileNameWithoutExtension().toStdString() };
+		const auto key{ std::regex_replace(name, regex, "", std::regex_constants::format_first_only) };
+		groups[file.m_file.getParentDirectory().getChildFile(juce::String(key)).getFullPathName()].push_back(&file);
+	}
+	return groups;
+}
+
+std::vector<float> zero::readOnsetWindow(juce::AudioFormatReader& reader, juce::int64 startSample, int windowSize)
+{
+	const auto numChannels{ static_cast<int>(reader.numChannels) };
+	juce::AudioBuffer<float> buffer{ numChannels, windowSize };
+	{
+		Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+		reader.read(&buffer, 0, windowSize, startSample, true, true);
+	}
+
+	std::vector<float> window(static_cast<size_t>(windowSize), 0.0f);
+	for (auto ch{ 0 }; ch < numChannels; ++ch)
+	{
+		juce::FloatVectorOperations::add(window.data(), buffer.getReadPointer(ch), windowSize);
+	}
+	return window;
+}
+
+Alignment zero::crossCorrelate(const std::vector<float>& reference, const std::vector<float>& signal)
+{
+	Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+	using Complex = std::complex<float>;
+
+	// Zero-pad to avoid circular wrap-around between positive and negative lags
+	const auto length{ std::max(reference.size(), signal.size()) };
+	auto order{ 1 };
+	while ((static_cast<size_t>(1) << order) < length * 2)
+	{
+		++order;
+	}
+	const auto fftSize{ static_cast<size_t>(1) << order };
+	const juce::dsp::FFT fft{ order };
+
+	std::vector<Complex> ref(fftSize), sig(fftSize), refSpectrum(fftSize), sigSpectrum(fftSize);
+	std::copy(reference.begin(), reference.end(), ref.begin());
+	std::copy(signal.begin(), signal.end(), sig.begin());
+	fft.perform(ref.data(), refSpectrum.data(), false);
+	fft.perform(sig.data(), sigSpectrum.data(), false);
+
+	// Correlation in the frequency domain: R = S * conj(X)
+	for (size_t bin{ 0 }; bin < fftSize; ++bin)
+	{
+		sigSpectrum[bin] *= std::conj(refSpectrum[bin]);
+	}
+	fft.perform(sigSpectrum.data(), sig.data(), true);
+
+	size_t peakIndex{ 0 };
+	for (size_t index{ 1 }; index < fftSize; ++index)
+	{
+		if (sig[index].real() > sig[peakIndex].real())
+		{
+			peakIndex = index;
+		}
+	}
+
+	Alignment alignment{};
+	alignment.m_offset = (peakIndex < fftSize / 2) ? static_cast<juce::int64>(peakIndex)
+	                                               : static_cast<juce::int64>(peakIndex) -
+	                                                 static_cast<juce::int64>(fftSize);
+
+	// Normalize in the time domain at the chosen lag, independent of FFT scaling
+	auto dot{ 0.0 };
+	auto refEnergy{ 0.0 };
+	auto sigEnergy{ 0.0 };
+	for (size_t index{ 0 }; index < reference.size(); ++index)
+	{
+		const auto sigIndex{ static_cast<juce::int64>(index) + alignment.m_offset };
+		const auto r{ static_cast<double>(reference[index]) };
+		refEnergy += r * r;
+		if (sigIndex >= 0 && sigIndex < static_cast<juce::int64>(signal.size()))
+		{
+			dot += r * signal[static_cast<size_t>(sigIndex)];
+		}
+	}
+	for (const auto s : signal)
+	{
+		sigEnergy += static_cast<double>(s) * s;
+	}
+
+	const auto norm{ std::sqrt(refEnergy * sigEnergy) };
+	alignment.m_correlation = (norm > 0.0) ? static_cast<float>(std::max(dot / norm, 0.0)) : 0.0f;
+	return alignment;
+}
@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    alignment.h
+    Created: 19 Oct 2026 2:12:40pm
+    Author:  Aaron Cendan
+    Description: Relative offsets within groups of synchronized assets via FFT cross-correlation
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "file.h"
+
+#include <JuceHeader.h>
+#include <map>
+
+namespace zero
+{
+	using FileGroups = std::map<juce::String, std::vector<File*>>;
+
+	// Groups by parent folder ("folder"), or by file name with the first match of a regex pattern removed
+	FileGroups groupFiles(std::vector<File>& files, const juce::String& pattern);
+
+	// Reads a bounded, mono-summed window starting at the given sample
+	std::vector<float> readOnsetWindow(juce::AudioFormatReader& reader, juce::int64 startSample, int windowSize);
+
+	struct Alignment
+	{
+		juce::int64 m_offset{ 0 };     // Samples the signal lags behind the reference
+		float m_correlation{ 0.0f };   // Normalized correlation at that lag, clamped to 0 - 1
+	};
+
+	Alignment crossCorrelate(const std::vector<float>& reference, const std::vector<float>& signal);
+}
@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+    analysis.cpp
+    Created: 19 Oct 2026 11:32:55am
+    Author:  Aaron Cendan
+    Description: Composable streaming analyzers, fed from a single decode pass per file
+
+  ==============================================================================
+*/
+
+#include "analysis.h"
+#include "file.h"
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_epsilon{ 0.0005f };
+	constexpr auto s_clipThreshold{ 0.9999f };
+}
+
+SearchWindows::SearchWindows(juce::int64 lengthInSamples, juce::int64 startSampleOffset,
+                             juce::int64 numSamplesToSearch)
+{
+	if (numSamplesToSearch < 0)
+	{
+		numSamplesToSearch = lengthInSamples;
+	}
+
+	const auto clip = [lengthInSamples](juce::int64 pos)
+	{
+		return juce::jlimit(static_cast<juce::int64>(0), lengthInSamples, pos);
+	};
+
+	// Forward scans up from the offset, reverse scans down from the offset before the end
+	const auto forwardStart{ clip(startSampleOffset) };
+	m_forward = { forwardStart, juce::jmax(forwardStart, clip(startSampleOffset + numSamplesToSearch)) };
+
+	const auto reverseEnd{ clip(lengthInSamples - startSampleOffset) };
+	m_reverse = { juce::jmin(reverseEnd, clip(lengthInSamples - startSampleOffset - numSamplesToSearch)), reverseEnd };
+}
+
+//==============================================================================
+LevelRun::LevelRun(int minConsecutiveSamples) : m_minConsecutiveSamples{ std::max(minConsecutiveSamples, 1) } { }
+
+void LevelRun::push(juce::int64 position, bool matches)
+{
+	if (!matches)
+	{
+		reset();
+		return;
+	}
+
+	if (m_runLength++ == 0)
+	{
+		m_runStart = position;
+	}
+
+	if (m_runLength >= m_minConsecutiveSamples)
+	{
+		if (m_firstRunStart < 0)
+		{
+			m_firstRunStart = m_runStart;
+		}
+		m_lastRunEnd = position + 1;
+	}
+}
+
+void LevelRun::reset()
+{
+	m_runStart = -1;
+	m_runLength = 0;
+}
+
+//==============================================================================
+ZeroAnalyzer::ZeroAnalyzer(double magnitudeRangeMin, double magnitudeRangeMax, int minConsecutiveSamples) :
+		m_magnitudeRangeMin{ static_cast<float>(magnitudeRangeMin) },
+		m_magnitudeRangeMax{ static_cast<float>(magnitudeRangeMax) },
+		m_forward{ minConsecutiveSamples },
+		m_reverse{ minConsecutiveSamples }
+{
+	jassert (magnitudeRangeMax > magnitudeRangeMin);
+}
+
+void ZeroAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	m_windows = windows;
+	m_lengthInSamples = reader.lengthInSamples;
+	m_sampleRate = reader.sampleRate;
+}
+
+void ZeroAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	const auto numChannels{ block.getNumChannels() };
+	for (auto index{ 0 }; index < numSamples; ++index)
+	{
+		const auto position{ blockStart + index };
+		const auto inForward{ m_windows.m_forward.contains(position) };
+		const auto inReverse{ m_windows.m_reverse.contains(position) };
+		if (!inForward && !inReverse)
+		{
+			continue;
+		}
+
+		auto matches{ false };
+		for (auto ch{ 0 }; ch < numChannels; ++ch)
+		{
+			const auto smpl{ std::abs(block.getReadPointer(ch)[index]) };
+			if (smpl >= m_magnitudeRangeMin && smpl <= m_magnitudeRangeMax)
+			{
+				matches = true;
+				break;
+			}
+		}
+
+		if (inForward && m_forward.m_firstRunStart < 0)
+		{
+			m_forward.push(position, matches);
+		}
+		if (inReverse)
+		{
+			m_reverse.push(position, matches);
+		}
+	}
+}
+
+void ZeroAnalyzer::finish(File& file)
+{
+	file.m_firstNonZeroSample = m_forward.m_firstRunStart;
+	file.m_firstNonZeroTime = juce::RelativeTime(static_cast<double>(file.m_firstNonZeroSample) / m_sampleRate);
+	file.m_lastNonZeroSample = (m_reverse.m_lastRunEnd < 0) ? -1 : m_lengthInSamples - m_reverse.m_lastRunEnd;
+	file.m_lastNonZeroTime = juce::RelativeTime(static_cast<double>(file.m_lastNonZeroSample) / m_sampleRate);
+}
+
+//==============================================================================
+void MonoAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	m_window = windows.m_forward;
+	m_numChannels = static_cast<int>(reader.numChannels);
+}
+
+void MonoAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	// Only the forward window contributes, as the reverse window may overlap it out of order
+	const auto range{ m_window.getIntersectionWith({ blockStart, blockStart + numSamples }) };
+	m_numSamples += range.getLength();
+	if (m_numChannels < 2 || range.isEmpty())
+	{
+		return;
+	}
+
+	const auto first{ static_cast<int>(range.getStart() - blockStart) };
+	const auto last{ static_cast<int>(range.getEnd() - blockStart) };
+	const auto firstChannel{ block.getReadPointer(0) };
+	for (auto sample{ first }; sample < last; ++sample)
+	{
+		auto isMono{ true };
+		for (auto channel{ 1 }; channel < m_numChannels && isMono; ++channel)
+		{
+			isMono = std::abs(block.getReadPointer(channel)[sample] - firstChannel[sample]) < s_epsilon;
+		}
+		m_numMonoSamples += isMono ? 1 : 0;
+	}
+}
+
+void MonoAnalyzer::merge(const MonoAnalyzer& other)
+{
+	m_numSamples += other.m_numSamples;
+	m_numMonoSamples += other.m_numMonoSamples;
+}
+
+void MonoAnalyzer::finish(File& file)
+{
+	file.m_numChannels = m_numChannels;
+	file.m_numSamples = m_numSamples;
+	if (m_numChannels == 1)
+	{
+		file.m_monoCompatibility = -1.0f;
+		return;
+	}
+
+	file.m_monoCompatibility = (m_numSamples > 0) ?
+	                           static_cast<float>(static_cast<double>(m_numMonoSamples) /
+	                                              static_cast<double>(m_numSamples)) : 0.0f;
+}
+
+//==============================================================================
+void LevelAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	m_window = windows.m_forward;
+	m_channelSums.assign(reader.numChannels, 0.0);
+}
+
+void LevelAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	// Only the forward window contributes, as the reverse window may overlap it out of order
+	const auto range{ m_window.getIntersectionWith({ blockStart, blockStart + numSamples }) };
+	if (range.isEmpty())
+	{
+		return;
+	}
+
+	const auto offset{ static_cast<int>(range.getStart() - blockStart) };
+	const auto numInWindow{ static_cast<int>(range.getLength()) };
+	m_numSamples += numInWindow;
+	for (auto channel{ 0 }; channel < block.getNumChannels(); ++channel)
+	{
+		const auto data{ block.getReadPointer(channel, offset) };
+		const auto minMax{ juce::FloatVectorOperations::findMinAndMax(data, numInWindow) };
+		m_peak = std::max({ m_peak, std::abs(minMax.getStart()), std::abs(minMax.getEnd()) });
+
+		auto sum{ 0.0 };
+		auto sumOfSquares{ 0.0 };
+		for (auto sample{ 0 }; sample < numInWindow; ++sample)
+		{
+			const auto smpl{ data[sample] };
+			sum += smpl;
+			sumOfSquares += static_cast<double>(smpl) * smpl;
+			m_numClippedSamples += (std::abs(smpl) >= s_clipThreshold) ? 1 : 0;
+		}
+		m_channelSums[static_cast<size_t>(channel)] += sum;
+		m_sumOfSquares += sumOfSquares;
+	}
+}
+
+void LevelAnalyzer::finish(File& file)
+{
+	const auto numChannelSamples{ static_cast<double>(m_numSamples) * static_cast<double>(m_channelSums.size()) };
+	file.m_peak = m_peak;
+	file.m_rms = (numChannelSamples > 0.0) ? static_cast<float>(std::sqrt(m_sumOfSquares / numChannelSamples)) : 0.0f;
+	file.m_numClippedSamples = m_numClippedSamples;
+
+	// Report the channel with the largest DC offset
+	file.m_dcOffset = 0.0f;
+	for (const auto sum : m_channelSums)
+	{
+		const auto mean{ (m_numSamples > 0) ? sum / static_cast<double>(m_numSamples) : 0.0 };
+		if (std::abs(mean) > std::abs(file.m_dcOffset))
+		{
+			file.m_dcOffset = static_cast<float>(mean);
+		}
+	}
+}
+
+//==============================================================================
+SegmentAnalyzer::SegmentAnalyzer(double magnitudeRangeMin, double magnitudeRangeMax, int minConsecutiveSamples,
+                                 double minGapSeconds) :
+		m_magnitudeRangeMin{ static_cast<float>(magnitudeRangeMin) },
+		m_magnitudeRangeMax{ static_cast<float>(magnitudeRangeMax) },
+		m_minGapSeconds{ minGapSeconds },
+		m_run{ minConsecutiveSamples }
+{
+	jassert (magnitudeRangeMax > magnitudeRangeMin);
+}
+
+void SegmentAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	m_window = windows.m_forward;
+	m_sampleRate = reader.sampleRate;
+	m_minGapSamples = std::max(static_cast<juce::int64>(m_minGapSeconds * reader.sampleRate),
+	                           static_cast<juce::int64>(1));
+}
+
+void SegmentAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	const auto numChannels{ block.getNumChannels() };
+	for (auto index{ 0 }; index < numSamples; ++index)
+	{
+		const auto position{ blockStart + index };
+		if (!m_window.contains(position))
+		{
+			continue;
+		}
+
+		auto matches{ false };
+		for (auto ch{ 0 }; ch < numChannels && !matches; ++ch)
+		{
+			const auto smpl{ std::abs(block.getReadPointer(ch)[index]) };
+			matches = smpl >= m_magnitudeRangeMin && smpl <= m_magnitudeRangeMax;
+		}
+
+		const auto wasSound{ m_run.m_runLength >= m_run.m_minConsecutiveSamples };
+		m_run.push(position, matches);
+		if (m_run.m_runLength < m_run.m_minConsecutiveSamples)
+		{
+			continue;
+		}
+
+		// A run just reached --consec; split the region if the silence before it was long enough
+		if (!wasSound)
+		{
+			const auto gapStart{ m_soundEnd };
+			const auto gapEnd{ m_run.m_runStart };
+			if (m_regionStart < 0)
+			{
+				m_regionStart = gapEnd;
+			}
+			else if (gapEnd - gapStart >= m_minGapSamples)
+			{
+				m_regions.emplace_back(m_regionStart, gapStart);
+				m_longestGap = std::max(m_longestGap, gapEnd - gapStart);
+				m_regionStart = gapEnd;
+			}
+		}
+		m_soundEnd = position + 1;
+	}
+}
+
+void SegmentAnalyzer::finish(File& file)
+{
+	if (m_regionStart >= 0)
+	{
+		m_regions.emplace_back(m_regionStart, m_soundEnd);
+	}
+
+	file.m_regions = std::move(m_regions);
+	file.m_longestGap = juce::RelativeTime(static_cast<double>(m_longestGap) / m_sampleRate);
+}
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    analysis.h
+    Created: 19 Oct 2026 11:32:47am
+    Author:  Aaron Cendan
+    Description: Composable streaming analyzers, fed from a single decode pass per file
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace zero
+{
+	struct File;
+
+	// Forward and reverse search windows for a given --offset and --num, clipped to the file
+	struct SearchWindows
+	{
+		SearchWindows(juce::int64 lengthInSamples, juce::int64 startSampleOffset, juce::int64 numSamplesToSearch);
+
+		juce::Range<juce::int64> m_forward{};
+		juce::Range<juce::int64> m_reverse{};
+	};
+
+	// Tracks runs of consecutive in-range samples, as required by --consec
+	struct LevelRun
+	{
+		explicit LevelRun(int minConsecutiveSamples);
+
+		void push(juce::int64 position, bool matches);
+		void reset();
+
+		int m_minConsecutiveSamples{ 1 };
+		juce::int64 m_runStart{ -1 };
+		juce::int64 m_runLength{ 0 };
+		juce::int64 m_firstRunStart{ -1 }; // Start of first run reaching minimum length
+		juce::int64 m_lastRunEnd{ -1 };    // One past the last sample of last run reaching minimum length
+	};
+
+	class Analyzer
+	{
+	public:
+		virtual ~Analyzer() = default;
+
+		virtual void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) = 0;
+		virtual void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) = 0;
+		virtual void finish(File& file) = 0;
+
+		// Only the forward window is decoded unless some analyzer also needs the reverse window
+		virtual bool needsReverseWindow() const { return false; }
+	};
+
+	// zerochecker: first and last non-zero samples, identical to searchForLevel in both directions
+	class ZeroAnalyzer : public Analyzer
+	{
+	public:
+		ZeroAnalyzer(double magnitudeRangeMin, double magnitudeRangeMax, int minConsecutiveSamples);
+
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+		bool needsReverseWindow() const override { return true; }
+
+	private:
+		float m_magnitudeRangeMin{ 0.0f };
+		float m_magnitudeRangeMax{ 1.0f };
+		LevelRun m_forward;
+		LevelRun m_reverse;
+		SearchWindows m_windows{ 0, 0, 0 };
+		juce::int64 m_lengthInSamples{ 0 };
+		double m_sampleRate{ 0.0 };
+	};
+
+	// monochecker: fraction of samples that are identical across all channels
+	class MonoAnalyzer : public Analyzer
+	{
+	public:
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+		// Adds counts from an analyzer that processed another part of the same file
+		void merge(const MonoAnalyzer& other);
+
+	private:
+		juce::Range<juce::int64> m_window{};
+		int m_numChannels{ 0 };
+		juce::int64 m_numSamples{ 0 };
+		juce::int64 m_numMonoSamples{ 0 };
+	};
+
+	// Cheap per-block level metrics: peak, RMS, DC offset and clipped sample count
+	class LevelAnalyzer : public Analyzer
+	{
+	public:
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+	private:
+		juce::Range<juce::int64> m_window{};
+		float m_peak{ 0.0f };
+		double m_sumOfSquares{ 0.0 };
+		std::vector<double> m_channelSums{};
+		juce::int64 m_numSamples{ 0 };
+		juce::int64 m_numClippedSamples{ 0 };
+	};
+
+	// Streaming run-length segmentation into sound regions separated by silent gaps of a minimum length
+	class SegmentAnalyzer : public Analyzer
+	{
+	public:
+		SegmentAnalyzer(double magnitudeRangeMin, double magnitudeRangeMax, int minConsecutiveSamples,
+		                double minGapSeconds);
+
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+	private:
+		float m_magnitudeRangeMin{ 0.0f };
+		float m_magnitudeRangeMax{ 1.0f };
+		double m_minGapSeconds{ 0.0 };
+		juce::int64 m_minGapSamples{ 0 };
+		LevelRun m_run;
+		juce::Range<juce::int64> m_window{};
+		double m_sampleRate{ 0.0 };
+
+		juce::int64 m_regionStart{ -1 };
+		juce::int64 m_soundEnd{ -1 };
+		juce::int64 m_longestGap{ 0 };
+		std::vector<juce::Range<juce::int64>> m_regions{};
+	};
+}
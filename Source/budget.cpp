@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    budget.cpp
+    Created: 19 Oct 2026 11:02:18pm
+    Author:  Aaron Cendan
+    Description: Memory admission control for --max-memory, throttling only the tasks that need large buffers
+
+  ==============================================================================
+*/
+
+#include "budget.h"
+#include "file.h"
+
+#include <utility>
+
+using namespace zero;
+
+namespace
+{
+	// Largest block any read or write path holds per channel, and a generous allowance for decoder state
+	constexpr juce::int64 s_blockBytesPerChannel{ 65536 * sizeof(float) };
+	constexpr juce::int64 s_readerOverheadBytes{ 1024 * 1024 };
+}
+
+MemoryBudget::Reservation::Reservation(MemoryBudget& budget, juce::int64 numBytes) :
+		m_budget{ &budget }, m_numBytes{ numBytes }
+{
+}
+
+MemoryBudget::Reservation::Reservation(Reservation&& other) noexcept :
+		m_budget{ std::exchange(other.m_budget, nullptr) }, m_numBytes{ std::exchange(other.m_numBytes, 0) }
+{
+}
+
+MemoryBudget::Reservation::~Reservation()
+{
+	if (m_budget != nullptr)
+	{
+		m_budget->release(m_numBytes);
+	}
+}
+
+MemoryBudget::MemoryBudget(juce::int64 maxBytes) : m_maxBytes{ std::max(maxBytes, static_cast<juce::int64>(0)) }
+{
+}
+
+MemoryBudget::Reservation MemoryBudget::reserve(juce::int64 numBytes)
+{
+	std::unique_lock lock{ m_mutex };
+	m_released.wait(lock, [&]
+	{
+		return m_reservedBytes == 0 || m_reservedBytes + numBytes <= m_maxBytes;
+	});
+	m_reservedBytes += numBytes;
+	return { *this, numBytes };
+}
+
+void MemoryBudget::release(juce::int64 numBytes)
+{
+	{
+		std::scoped_lock lock{ m_mutex };
+		m_reservedBytes -= numBytes;
+	}
+	m_released.notify_all();
+}
+
+juce::int64 MemoryBudget::estimateWorkingSet(const juce::AudioFormatReader& reader)
+{
+	// Long recordings are split into chunks that each get their own reader, up to one per core
+	const auto isSplit{ reader.lengthInSamples >= File::s_parallelChunkSize * File::s_minParallelChunks };
+	const auto numWorkers{ isSplit ? juce::SystemStats::getNumCpus() : 1 };
+
+	// One buffer for decoding and one for the writer or sample conversion
+	const auto bytesPerWorker{ 2 * static_cast<juce::int64>(reader.numChannels) * s_blockBytesPerChannel +
+	                           s_readerOverheadBytes };
+	return numWorkers * bytesPerWorker;
+}
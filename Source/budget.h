@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    budget.h
+    Created: 19 Oct 2026 11:02:18pm
+    Author:  Aaron Cendan
+    Description: Memory admission control for --max-memory, throttling only the tasks that need large buffers
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace zero
+{
+	// Shared byte budget for concurrent per-file tasks. A task reserves its estimated working set before it starts and
+	// waits while that would overrun the budget; a task bigger than the whole budget runs once nothing else is reserved,
+	// so every file is still processed. Files below s_largeFileBytes never reserve and keep full parallelism.
+	class MemoryBudget
+	{
+	public:
+		static constexpr juce::int64 s_largeFileBytes{ 64 * 1024 * 1024 };
+
+		class Reservation
+		{
+		public:
+			Reservation() = default;
+			Reservation(MemoryBudget& budget, juce::int64 numBytes);
+			Reservation(Reservation&& other) noexcept;
+			Reservation& operator=(Reservation&& other) = delete;
+			~Reservation();
+
+		private:
+			MemoryBudget* m_budget{ nullptr };
+			juce::int64 m_numBytes{ 0 };
+		};
+
+		explicit MemoryBudget(juce::int64 maxBytes);
+
+		// Blocks until numBytes fit within the budget
+		Reservation reserve(juce::int64 numBytes);
+
+		juce::int64 getMaxBytes() const { return m_maxBytes; }
+
+		// Decode and write buffers for every worker a file can fan out to, plus decoder state and stream buffers
+		static juce::int64 estimateWorkingSet(const juce::AudioFormatReader& reader);
+
+	private:
+		void release(juce::int64 numBytes);
+
+		std::mutex m_mutex{};
+		std::condition_variable m_released{};
+		juce::int64 m_maxBytes{ 0 };
+		juce::int64 m_reservedBytes{ 0 };
+	};
+}
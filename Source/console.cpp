@@ -16,42 +16,65 @@ using namespace zero;
 
 namespace
 {
+	constexpr auto s_highClickRisk{ 0.5f };
+	constexpr auto s_loudnessTolerance{ 1.0f }; // LU either side of --loudness
+	constexpr auto s_maxTruePeak{ -1.0f };      // dBTP
+
 	void ignoreLine()
 	{
 		std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 	}
-}
 
-Console::Console(Checker& checker, const std::optional<juce::String>& csv /*= std::nullopt*/, int numItems) :
-		m_numItems{ numItems }, m_checker{ checker }
-{
-	// Init table
-	m_table.clear();
-	m_table.setIndent(1, 1);
+	// File names may contain separators or quotes, so those fields are quoted as in RFC 4180
+	std::string toCsvField(std::string_view field)
+	{
+		if (field.find_first_of(std::string{ "\"\r\n" } + ltrl::sep) == std::string_view::npos)
+		{
+			return std::string{ field };
+		}
 
-	// Init stats
-	m_stats.clear();
-	m_stats.setIndent(1, 1);
+		std::string quoted{ "\"" };
+		for (const auto c : field)
+		{
+			quoted += (c == '"') ? "\"\"" : std::string(1, c);
+		}
+		return quoted + "\"";
+	}
+
+	std::string toDecibelString(float gain)
+	{
+		return juce::String(juce::Decibels::gainToDecibels(gain), 2).toStdString();
+	}
+
+	void initTable(samilton::ConsoleTable& table)
+	{
+		table.clear();
+		table.setIndent(1, 1);
 
-	// Per-platform character encoding for output table (unicode by default)
+		// Per-platform character encoding for output table (unicode by default)
 #if defined (JUCE_WINDOWS)
-	samilton::ConsoleTable::TableChars chars;
+		samilton::ConsoleTable::TableChars chars;
 #else
-	samilton::ConsoleTable::TableChars chars{ '+', '+', '+', '+', '-', '+', '+', '|', '+', '+', '+' };
+		samilton::ConsoleTable::TableChars chars{ '+', '+', '+', '+', '-', '+', '+', '|', '+', '+', '+' };
 #endif
-	m_table.setTableChars(chars);
-	m_stats.setTableChars(chars);
+		table.setTableChars(chars);
+	}
+}
+
+Console::Console(Checker& checker, const std::optional<juce::String>& csv /*= std::nullopt*/, int numItems) :
+		m_numItems{ numItems }, m_checker{ checker }
+{
+	// Init table and stats
+	initTable(m_table);
+	initTable(m_stats);
 
 	m_startTime = juce::Time::getCurrentTime();
 
 	// Init CSV
 	if (csv.has_value() && !csv->isEmpty())
 	{
-		m_csvFile = juce::File::createLegalPathName(*csv);
-		if (!m_csvFile->hasFileExtension("csv"))
-		{
-			m_csvFile = m_csvFile->withFileExtension("csv");
-		}
+		m_csvFile = getOutputFile(*csv);
+		m_ndjson = m_csvFile->hasFileExtension("ndjson;jsonl");
 		m_csvFile->create();
 		m_csvText = juce::String();
 	}
@@ -70,6 +93,67 @@ Console::Console(Checker& checker, const std::optional<juce::String>& csv /*= st
 		append({ "File Name", "Mono Compatibility" });
 		break;
 	}
+	case Checker::AnalysisMode::MULTI_ANALYSIS:
+	{
+		std::vector<std::string> headers{ "File Name" };
+		if (m_checker.hasAnalysis(Checker::Analysis::ZERO))
+		{
+			headers.insert(headers.end(), { "First Non-Zero (smpls)", "First Non-Zero (sec)", "Last Non-Zero (smpls)",
+			                                "Last Non-Zero (sec)" });
+		}
+		if (m_checker.hasAnalysis(Checker::Analysis::MONO))
+		{
+			headers.emplace_back("Mono Compatibility");
+		}
+		if (m_checker.hasAnalysis(Checker::Analysis::LEVEL))
+		{
+			headers.insert(headers.end(), { "Peak (dBFS)", "RMS (dBFS)", "DC Offset", "Clipped Samples" });
+		}
+		append(headers);
+		break;
+	}
+	case Checker::AnalysisMode::LOOP_CHECKER:
+	{
+		append({ "File Name", "Amplitude Jump", "Slope Jump", "Spectral Distance (dB)", "Seam Excess (dB)",
+		         "Click Risk" });
+		break;
+	}
+	case Checker::AnalysisMode::GAP_SEGMENTER:
+	{
+		append({ "File Name", "Regions", "Gaps", "Longest Gap (sec)", "Region Boundaries (smpls)" });
+		break;
+	}
+	case Checker::AnalysisMode::ALIGNMENT_CHECKER:
+	{
+		append({ "File Name", "Group", "Reference", "Offset (smpls)", "Offset (ms)", "Correlation" });
+		break;
+	}
+	case Checker::AnalysisMode::DUPLICATE_FINDER:
+	{
+		append({ "File Name", "Near-Duplicates", "Closest Match", "Similarity", "Keep" });
+		break;
+	}
+	case Checker::AnalysisMode::THRESHOLD_SWEEP:
+	{
+		// Same order as File::calculateSweep: every count for the first minimum, then the next minimum
+		std::vector<std::string> headers{ "File Name" };
+		for (const auto min : m_checker.m_sweepMinimums.val)
+		{
+			for (const auto consec : m_checker.getSweepConsecutiveSamples())
+			{
+				const auto config{ "(min " + juce::String(min) + ", consec " + juce::String(consec) + ")" };
+				headers.emplace_back(("First Non-Zero " + config).toStdString());
+				headers.emplace_back(("Last Non-Zero " + config).toStdString());
+			}
+		}
+		append(headers);
+		break;
+	}
+	case Checker::AnalysisMode::LOUDNESS_CHECKER:
+	{
+		append({ "File Name", "Integrated (LUFS)", "Loudness Range (LU)", "True Peak (dBTP)", "Target Deviation (LU)" });
+		break;
+	}
 	}
 }
 
@@ -77,9 +161,17 @@ void Console::print()
 {
 	m_endTime = juce::Time::getCurrentTime();
 
+	std::optional<Profiler::ScopedStage> outputStage{ Profiler::Stage::OUTPUT };
 	switch (m_checker.m_analysisMode)
 	{
 	case Checker::AnalysisMode::ZERO_CHECKER:
+	case Checker::AnalysisMode::MULTI_ANALYSIS:
+	case Checker::AnalysisMode::LOOP_CHECKER:
+	case Checker::AnalysisMode::GAP_SEGMENTER:
+	case Checker::AnalysisMode::ALIGNMENT_CHECKER:
+	case Checker::AnalysisMode::DUPLICATE_FINDER:
+	case Checker::AnalysisMode::THRESHOLD_SWEEP:
+	case Checker::AnalysisMode::LOUDNESS_CHECKER:
 	{
 		std::cout << ltrl::zerocheckerASCII;
 		break;
@@ -97,8 +189,43 @@ void Console::print()
 	printCsv();
 
 	std::cout << ltrl::divider << ltrl::endl;
+	outputStage.reset();
 
 	promptProcess();
+	printProfile();
+}
+
+void Console::printRows()
+{
+	if (m_numRows <= 1)
+	{
+		return;
+	}
+
+	Profiler::ScopedStage stage{ Profiler::Stage::OUTPUT };
+	std::cout << juce::Time::getCurrentTime().toString(true, true, true, true) << ltrl::endl << m_table << ltrl::endl
+	          << std::flush;
+
+	// Only new rows are written, so the CSV keeps growing for as long as --watch runs, and across restarts
+	if (m_csvFile.has_value() && m_csvText.has_value() && !m_csvText->isEmpty())
+	{
+		if (!m_csvStarted && !m_ndjson && m_csvFile->getSize() > 0)
+		{
+			// The existing log already starts with a header row
+			*m_csvText = m_csvText->fromFirstOccurrenceOf(ltrl::endl, true, false);
+		}
+		m_csvFile->appendText(*m_csvText);
+		m_csvStarted = true;
+		m_csvText->clear();
+	}
+
+	// Next batch starts from the header row again
+	initTable(m_table);
+	for (size_t col{ 0 }; col < m_header.size(); ++col)
+	{
+		m_table[0][col] = m_header[col];
+	}
+	m_numRows = 1;
 }
 
 void Console::printStats()
@@ -112,7 +239,11 @@ void Console::printStats()
 	{
 	case Checker::AnalysisMode::ZERO_CHECKER:
 	{
-		//TODO: Add unique stats for default zerochecker mode
+		m_stats.addRow({ "Number of digitally silent files", std::to_string(m_numSilentFiles).c_str() });
+		if (m_checker.m_pyramidDirectory.val.has_value())
+		{
+			m_stats.addRow({ "Peak pyramids reused", std::to_string(m_checker.m_numReusedPyramids).c_str() });
+		}
 		break;
 	}
 	case Checker::AnalysisMode::MONO_COMPATIBILITY_CHECKER:
@@ -122,6 +253,60 @@ void Console::printStats()
 		                 juce::File::descriptionOfSizeInBytes(m_checker.m_sizeSavingsBytes).toRawUTF8() });
 		break;
 	}
+	case Checker::AnalysisMode::MULTI_ANALYSIS:
+	{
+		if (m_checker.hasAnalysis(Checker::Analysis::MONO))
+		{
+			m_stats.addRow({ "Number of mono compatible files", std::to_string(m_checker.m_numMonoFiles).c_str() });
+			m_stats.addRow({ "Potential space savings by converting to mono",
+			                 juce::File::descriptionOfSizeInBytes(m_checker.m_sizeSavingsBytes).toRawUTF8() });
+		}
+		if (m_checker.hasAnalysis(Checker::Analysis::LEVEL))
+		{
+			m_stats.addRow({ "Number of files with clipped samples", std::to_string(m_numClippedFiles).c_str() });
+		}
+		break;
+	}
+	case Checker::AnalysisMode::LOOP_CHECKER:
+	{
+		m_stats.addRow({ "Number of loops with high click risk", std::to_string(m_checker.m_numClickyLoops).c_str() });
+		break;
+	}
+	case Checker::AnalysisMode::GAP_SEGMENTER:
+	{
+		m_stats.addRow({ "Number of files with internal gaps", std::to_string(m_checker.m_numSegmentedFiles).c_str() });
+		break;
+	}
+	case Checker::AnalysisMode::ALIGNMENT_CHECKER:
+	{
+		m_stats.addRow({ "Number of groups", std::to_string(m_checker.m_numAlignmentGroups).c_str() });
+		m_stats.addRow({ "Number of misaligned files", std::to_string(m_checker.m_numMisalignedFiles).c_str() });
+		break;
+	}
+	case Checker::AnalysisMode::DUPLICATE_FINDER:
+	{
+		m_stats.addRow({ "Number of files with near-duplicates", std::to_string(m_checker.m_numDuplicateFiles).c_str() });
+		m_stats.addRow({ "Potential space savings by removing near-duplicates",
+		                 juce::File::descriptionOfSizeInBytes(m_checker.m_sizeSavingsBytes).toRawUTF8() });
+		m_stats.addRow({ "Fingerprints reused from index", std::to_string(m_checker.m_numReusedFingerprints).c_str() });
+		break;
+	}
+	case Checker::AnalysisMode::THRESHOLD_SWEEP:
+	{
+		const auto numConfigurations{ m_checker.m_sweepMinimums.val.size() *
+		                              m_checker.getSweepConsecutiveSamples().size() };
+		m_stats.addRow({ "Configurations per file", std::to_string(numConfigurations).c_str() });
+		break;
+	}
+	case Checker::AnalysisMode::LOUDNESS_CHECKER:
+	{
+		m_stats.addRow({ "Target integrated loudness (LUFS)", juce::String(m_checker.m_loudnessTarget.val, 1).toRawUTF8() });
+		m_stats.addRow({ ("Number of files more than " + juce::String(s_loudnessTolerance, 1) + " LU off target").toRawUTF8(),
+		                 std::to_string(m_numOffTargetFiles).c_str() });
+		m_stats.addRow({ ("Number of files above " + juce::String(s_maxTruePeak, 1) + " dBTP").toRawUTF8(),
+		                 std::to_string(m_numTruePeakFiles).c_str() });
+		break;
+	}
 	}
 
 	std::cout << m_stats << ltrl::endl;
@@ -129,15 +314,184 @@ void Console::printStats()
 
 void Console::printCsv()
 {
-	if (m_csvFile.has_value() && m_csvText.has_value() && m_csvFile->existsAsFile() && !m_csvText->isEmpty())
+	if (m_csvFile.has_value() && m_csvText.has_value() && m_ndjson)
+	{
+		// Trailing stats record, summed by --merge
+		auto* obj{ new juce::DynamicObject() };
+		obj->setProperty("stats", statsToVar());
+		m_csvFile->replaceWithText(*m_csvText + juce::JSON::toString(juce::var{ obj }, true) + ltrl::endl);
+		std::cout << "Output NDJSON to: " << m_csvFile->getFullPathName() << ltrl::endl;
+	}
+	else if (m_csvFile.has_value() && m_csvText.has_value() && m_csvFile->existsAsFile() && !m_csvText->isEmpty())
 	{
 		m_csvFile->replaceWithText(*m_csvText);
 		std::cout << "Output CSV to: " << m_csvFile->getFullPathName() << ltrl::endl;
 	}
 }
 
+juce::var Console::statsToVar() const
+{
+	auto* obj{ new juce::DynamicObject() };
+	obj->setProperty("mode", static_cast<int>(m_checker.m_analysisMode));
+	obj->setProperty("analyses", m_checker.m_analyses.val);
+	obj->setProperty("pyramid", m_checker.m_pyramidDirectory.val.has_value());
+	obj->setProperty("files", m_numItems);
+	obj->setProperty("monoFiles", m_checker.m_numMonoFiles);
+	obj->setProperty("clippedFiles", m_numClippedFiles);
+	obj->setProperty("silentFiles", m_numSilentFiles);
+	obj->setProperty("offTargetFiles", m_numOffTargetFiles);
+	obj->setProperty("truePeakFiles", m_numTruePeakFiles);
+	obj->setProperty("loudnessTarget", m_checker.m_loudnessTarget.val);
+	obj->setProperty("clickyLoops", m_checker.m_numClickyLoops);
+	obj->setProperty("segmentedFiles", m_checker.m_numSegmentedFiles);
+	obj->setProperty("alignmentGroups", m_checker.m_numAlignmentGroups);
+	obj->setProperty("misalignedFiles", m_checker.m_numMisalignedFiles);
+	obj->setProperty("duplicateFiles", m_checker.m_numDuplicateFiles);
+	obj->setProperty("reusedFingerprints", m_checker.m_numReusedFingerprints.load());
+	obj->setProperty("reusedPyramids", m_checker.m_numReusedPyramids.load());
+	obj->setProperty("sizeSavingsBytes", m_checker.m_sizeSavingsBytes);
+	return obj;
+}
+
+void Console::addStats(const juce::var& stats)
+{
+	m_checker.m_numMonoFiles += static_cast<int>(stats["monoFiles"]);
+	m_numClippedFiles += static_cast<int>(stats["clippedFiles"]);
+	m_numSilentFiles += static_cast<int>(stats["silentFiles"]);
+	m_numOffTargetFiles += static_cast<int>(stats["offTargetFiles"]);
+	m_numTruePeakFiles += static_cast<int>(stats["truePeakFiles"]);
+	m_checker.m_numClickyLoops += static_cast<int>(stats["clickyLoops"]);
+	m_checker.m_numSegmentedFiles += static_cast<int>(stats["segmentedFiles"]);
+	m_checker.m_numAlignmentGroups += static_cast<int>(stats["alignmentGroups"]);
+	m_checker.m_numMisalignedFiles += static_cast<int>(stats["misalignedFiles"]);
+	m_checker.m_numDuplicateFiles += static_cast<int>(stats["duplicateFiles"]);
+	m_checker.m_numReusedFingerprints += static_cast<int>(stats["reusedFingerprints"]);
+	m_checker.m_numReusedPyramids += static_cast<int>(stats["reusedPyramids"]);
+	m_checker.m_sizeSavingsBytes += static_cast<juce::int64>(stats["sizeSavingsBytes"]);
+}
+
+void Console::setHeader(const std::vector<std::string>& header)
+{
+	initTable(m_table);
+	m_numRows = 0;
+	if (m_csvText.has_value())
+	{
+		m_csvText->clear();
+	}
+	append(header);
+}
+
+void Console::printProfile()
+{
+	auto& profiler{ Profiler::get() };
+	if (!profiler.isEnabled())
+	{
+		return;
+	}
+
+	const auto report{ profiler.report() };
+
+	// Aggregate totals, with percentiles approximated by the upper bound of their histogram bucket
+	samilton::ConsoleTable totals{};
+	initTable(totals);
+	totals.addRow({ "Stage", "Thread Time", "Samples", "Mean", "p50", "p90", "p99", "Max" });
+
+	auto percentile = [](const Profiler::StageTimes& times, double fraction)
+	{
+		const auto target{ static_cast<juce::int64>(std::ceil(static_cast<double>(times.m_count) * fraction)) };
+		juce::int64 seen{ 0 };
+		for (auto bucket{ 0 }; bucket < Profiler::s_numBuckets; ++bucket)
+		{
+			seen += times.m_histogram[static_cast<size_t>(bucket)];
+			if (seen >= target)
+			{
+				return Profiler::bucketToString(bucket);
+			}
+		}
+		return Profiler::bucketToString(Profiler::s_numBuckets - 1);
+	};
+
+	for (auto stage{ 0 }; stage < Profiler::s_numStages; ++stage)
+	{
+		const auto& times{ report.m_stages[static_cast<size_t>(stage)] };
+		if (times.m_count == 0)
+		{
+			continue;
+		}
+		totals.addRow({ Profiler::stageName(static_cast<Profiler::Stage>(stage)),
+		                Profiler::ticksToString(times.m_ticks).toRawUTF8(),
+		                std::to_string(times.m_count).c_str(),
+		                Profiler::ticksToString(times.m_ticks / times.m_count).toRawUTF8(),
+		                percentile(times, 0.5).toRawUTF8(),
+		                percentile(times, 0.9).toRawUTF8(),
+		                percentile(times, 0.99).toRawUTF8(),
+		                Profiler::ticksToString(times.m_maxTicks).toRawUTF8() });
+	}
+	std::cout << ltrl::endl << "Profile (per-file samples, summed across threads)" << ltrl::endl << totals << ltrl::endl;
+
+	// Latency histogram, one column per stage
+	samilton::ConsoleTable histogram{};
+	initTable(histogram);
+	histogram[0][0] = "Latency";
+	for (auto stage{ 0 }; stage < Profiler::s_numStages; ++stage)
+	{
+		histogram[0][static_cast<size_t>(stage + 1)] = Profiler::stageName(static_cast<Profiler::Stage>(stage));
+	}
+
+	size_t row{ 1 };
+	for (auto bucket{ 0 }; bucket < Profiler::s_numBuckets; ++bucket)
+	{
+		const auto isEmpty{ std::all_of(report.m_stages.begin(), report.m_stages.end(), [bucket](const auto& times)
+		{
+			return times.m_histogram[static_cast<size_t>(bucket)] == 0;
+		}) };
+		if (isEmpty)
+		{
+			continue;
+		}
+
+		histogram[row][0] = Profiler::bucketToString(bucket).toStdString();
+		for (auto stage{ 0 }; stage < Profiler::s_numStages; ++stage)
+		{
+			histogram[row][static_cast<size_t>(stage + 1)] = std::to_string(
+					report.m_stages[static_cast<size_t>(stage)].m_histogram[static_cast<size_t>(bucket)]);
+		}
+		++row;
+	}
+	std::cout << histogram << ltrl::endl;
+
+	// Slowest files, to spot pathological assets
+	if (!report.m_slowestFiles.empty())
+	{
+		samilton::ConsoleTable slowest{};
+		initTable(slowest);
+		slowest.addRow({ "Slowest Files", "Total", "Reader/header", "Decode", "Compute", "Output", "Process" });
+		for (const auto& slowFile : report.m_slowestFiles)
+		{
+			auto stageTicks = [&slowFile](Profiler::Stage stage)
+			{
+				return Profiler::ticksToString(slowFile.m_stageTicks[static_cast<size_t>(stage)]);
+			};
+			slowest.addRow({ slowFile.m_file.getFileName().toRawUTF8(),
+			                 Profiler::ticksToString(slowFile.m_totalTicks).toRawUTF8(),
+			                 stageTicks(Profiler::Stage::READER).toRawUTF8(),
+			                 stageTicks(Profiler::Stage::DECODE).toRawUTF8(),
+			                 stageTicks(Profiler::Stage::COMPUTE).toRawUTF8(),
+			                 stageTicks(Profiler::Stage::OUTPUT).toRawUTF8(),
+			                 stageTicks(Profiler::Stage::PROCESS).toRawUTF8() });
+		}
+		std::cout << slowest << ltrl::endl;
+	}
+}
+
 void Console::promptProcess()
 {
+	// Nothing to process when printing merged shard results
+	if (m_checker.m_files.val.empty())
+	{
+		return;
+	}
+
 	switch (m_checker.m_analysisMode)
 	{
 	case Checker::AnalysisMode::ZERO_CHECKER:
@@ -159,6 +513,25 @@ void Console::promptProcess()
 		}
 		break;
 	}
+	case Checker::AnalysisMode::GAP_SEGMENTER:
+	{
+		if (m_checker.m_numSegmentedFiles > 0 &&
+		    promptContinue("Would you like to split all files with internal gaps into separate region files?"))
+		{
+			m_checker.processFiles();
+			std::cout << ltrl::endl << "Split " << m_checker.m_numSegmentedFiles << " files into regions!" << ltrl::endl;
+		}
+		break;
+	}
+	case Checker::AnalysisMode::MULTI_ANALYSIS:
+	case Checker::AnalysisMode::LOOP_CHECKER:
+	case Checker::AnalysisMode::ALIGNMENT_CHECKER:
+	case Checker::AnalysisMode::DUPLICATE_FINDER:
+	case Checker::AnalysisMode::THRESHOLD_SWEEP:
+	case Checker::AnalysisMode::LOUDNESS_CHECKER:
+	{
+		break;
+	}
 	}
 }
 
@@ -188,45 +561,142 @@ bool Console::promptContinue(std::string_view question)
 
 void Console::append(const std::initializer_list<const char*>& row, const juce::String& fullPath)
 {
-	m_table.addRow(row);
+	append(std::vector<std::string>(row.begin(), row.end()), fullPath);
+}
 
-	if (m_csvFile.has_value() && m_csvText.has_value())
+void Console::append(const std::vector<std::string>& row, const juce::String& fullPath)
+{
+	for (size_t col{ 0 }; col < row.size(); ++col)
+	{
+		m_table[m_numRows][col] = row[col];
+	}
+	if (m_numRows++ == 0)
+	{
+		m_header = row;
+	}
+
+	if (m_csvFile.has_value() && m_csvText.has_value() && m_ndjson)
+	{
+		// One object per row, keyed by the header, so shard outputs can be merged without parsing columns
+		if (m_numRows > 1)
+		{
+			auto* obj{ new juce::DynamicObject() };
+			obj->setProperty(ltrl::fullPathHeader, fullPath);
+			for (size_t col{ 0 }; col < row.size() && col < m_header.size(); ++col)
+			{
+				obj->setProperty(juce::String(m_header[col]), juce::String(row[col]));
+			}
+			*m_csvText += juce::JSON::toString(juce::var{ obj }, true) + ltrl::endl;
+		}
+	}
+	else if (m_csvFile.has_value() && m_csvText.has_value())
 	{
 		// Prep full path column on new rows
-		if (m_csvText->isEmpty())
+		if (m_numRows == 1)
 		{
 			m_csvText->append(ltrl::fullPathHeader, strlen(ltrl::fullPathHeader));
 			m_csvText->append(ltrl::sep, strlen(ltrl::sep));
 		}
 		else
 		{
+			const auto path{ toCsvField(fullPath.toStdString()) };
 			m_csvText->append(ltrl::endl, strlen(ltrl::endl));
-			m_csvText->append(fullPath, fullPath.length());
+			m_csvText->append(path, path.size());
 			m_csvText->append(ltrl::sep, strlen(ltrl::sep));
 		}
 
 		// Print table row
 		for (const auto& col : row)
 		{
-			m_csvText->append(col, strlen(col));
+			const auto field{ toCsvField(col) };
+			m_csvText->append(field, field.size());
 			m_csvText->append(ltrl::sep, strlen(ltrl::sep));
 		}
 	}
 }
 
+juce::File Console::getOutputFile(const juce::String& csv)
+{
+	const auto file{ juce::File::getCurrentWorkingDirectory().getChildFile(juce::File::createLegalPathName(csv)) };
+	return file.hasFileExtension("csv;ndjson;jsonl") ? file : file.withFileExtension("csv");
+}
+
+std::vector<std::vector<std::string>> Console::parseCsv(std::string_view text)
+{
+	std::vector<std::vector<std::string>> rows{};
+	std::vector<std::string> fields{};
+	std::string field{};
+	auto quoted{ false };
+
+	auto endRow = [&]
+	{
+		fields.push_back(std::move(field));
+		field.clear();
+		if (fields.size() > 1 || !fields.front().empty())
+		{
+			rows.push_back(std::move(fields));
+		}
+		fields.clear();
+	};
+
+	for (size_t i{ 0 }; i < text.size(); ++i)
+	{
+		const auto c{ text[i] };
+		if (quoted)
+		{
+			// Doubled quotes are literal, a single one closes the field
+			if (c != '"')
+			{
+				field += c;
+			}
+			else if (i + 1 < text.size() && text[i + 1] == '"')
+			{
+				field += c;
+				++i;
+			}
+			else
+			{
+				quoted = false;
+			}
+		}
+		else if (c == '"')
+		{
+			quoted = true;
+		}
+		else if (c == ltrl::sep[0])
+		{
+			fields.push_back(std::move(field));
+			field.clear();
+		}
+		else if (c == '\n')
+		{
+			endRow();
+		}
+		else if (c != '\r')
+		{
+			field += c;
+		}
+	}
+	endRow();
+	return rows;
+}
+
 void Console::append(const File& file)
 {
 	switch (m_checker.m_analysisMode)
 	{
 	case Checker::AnalysisMode::ZERO_CHECKER:
 	{
+		// Files of nothing but exact zeros are reported as their own category rather than as not found
+		m_numSilentFiles += file.m_isDigitalSilence ? 1 : 0;
+		const auto* missing{ file.m_isDigitalSilence ? ltrl::silent : ltrl::nil };
 		append({ file.m_file.getFileName().toStdString().c_str(),
-		         (file.m_firstNonZeroSample >= 0) ? std::to_string(file.m_firstNonZeroSample).c_str() : ltrl::nil,
+		         (file.m_firstNonZeroSample >= 0) ? std::to_string(file.m_firstNonZeroSample).c_str() : missing,
 		         (file.m_firstNonZeroSample >= 0) ? File::relTimeToString(file.m_firstNonZeroTime).toStdString().c_str()
-		                                          : ltrl::nil,
-		         (file.m_lastNonZeroSample >= 0) ? std::to_string(file.m_lastNonZeroSample).c_str() : ltrl::nil,
+		                                          : missing,
+		         (file.m_lastNonZeroSample >= 0) ? std::to_string(file.m_lastNonZeroSample).c_str() : missing,
 		         (file.m_lastNonZeroSample >= 0) ? File::relTimeToString(file.m_lastNonZeroTime).toStdString().c_str()
-		                                         : ltrl::nil },
+		                                         : missing },
 		       file.m_file.getFullPathName());
 		break;
 	}
@@ -241,6 +711,149 @@ void Console::append(const File& file)
 		       file.m_file.getFullPathName());
 		break;
 	}
+	case Checker::AnalysisMode::MULTI_ANALYSIS:
+	{
+		std::vector<std::string> row{ file.m_file.getFileName().toStdString() };
+		if (m_checker.hasAnalysis(Checker::Analysis::ZERO))
+		{
+			row.emplace_back((file.m_firstNonZeroSample >= 0) ? std::to_string(file.m_firstNonZeroSample) : ltrl::nil);
+			row.emplace_back((file.m_firstNonZeroSample >= 0) ? File::relTimeToString(file.m_firstNonZeroTime).toStdString()
+			                                                  : ltrl::nil);
+			row.emplace_back((file.m_lastNonZeroSample >= 0) ? std::to_string(file.m_lastNonZeroSample) : ltrl::nil);
+			row.emplace_back((file.m_lastNonZeroSample >= 0) ? File::relTimeToString(file.m_lastNonZeroTime).toStdString()
+			                                                 : ltrl::nil);
+		}
+		if (m_checker.hasAnalysis(Checker::Analysis::MONO))
+		{
+			if (file.m_monoCompatibility > m_checker.m_monoAnalysisThreshold.val)
+			{
+				m_checker.m_numMonoFiles++;
+				m_checker.m_sizeSavingsBytes += file.m_file.getSize() - (file.m_file.getSize() / file.m_numChannels);
+			}
+
+			auto monoCompatibility{ std::to_string(file.m_monoCompatibility) };
+			monoCompatibility.resize(6);
+			row.emplace_back((file.m_monoCompatibility >= 0.0f) ? monoCompatibility : ltrl::nil);
+		}
+		if (m_checker.hasAnalysis(Checker::Analysis::LEVEL))
+		{
+			m_numClippedFiles += (file.m_numClippedSamples > 0) ? 1 : 0;
+			row.emplace_back(toDecibelString(file.m_peak));
+			row.emplace_back(toDecibelString(file.m_rms));
+			row.emplace_back(juce::String(file.m_dcOffset, 6).toStdString());
+			row.emplace_back(std::to_string(file.m_numClippedSamples));
+		}
+		append(row, file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::LOOP_CHECKER:
+	{
+		const auto& seam{ file.m_loopSeam };
+		if (seam.m_clickRisk < 0.0f)
+		{
+			append({ file.m_file.getFileName().toStdString().c_str(), ltrl::nil, ltrl::nil, ltrl::nil, ltrl::nil,
+			         ltrl::nil }, file.m_file.getFullPathName());
+			break;
+		}
+
+		m_checker.m_numClickyLoops += (seam.m_clickRisk >= s_highClickRisk) ? 1 : 0;
+		append({ file.m_file.getFileName().toStdString().c_str(),
+		         juce::String(seam.m_amplitudeJump, 6).toRawUTF8(),
+		         juce::String(seam.m_slopeJump, 6).toRawUTF8(),
+		         juce::String(seam.m_spectralDistance, 2).toRawUTF8(),
+		         juce::String(seam.m_seamExcess, 2).toRawUTF8(),
+		         juce::String(seam.m_clickRisk, 3).toRawUTF8() },
+		       file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::GAP_SEGMENTER:
+	{
+		m_checker.m_numSegmentedFiles += (file.m_regions.size() > 1) ? 1 : 0;
+
+		juce::StringArray boundaries{};
+		for (const auto& region : file.m_regions)
+		{
+			boundaries.add(juce::String(region.getStart()) + "-" + juce::String(region.getEnd()));
+		}
+
+		const auto numGaps{ file.m_regions.empty() ? 0 : file.m_regions.size() - 1 };
+		append({ file.m_file.getFileName().toStdString().c_str(),
+		         std::to_string(file.m_regions.size()).c_str(),
+		         std::to_string(numGaps).c_str(),
+		         (numGaps > 0) ? File::relTimeToString(file.m_longestGap).toRawUTF8() : ltrl::nil,
+		         boundaries.joinIntoString(" ").toRawUTF8() },
+		       file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::ALIGNMENT_CHECKER:
+	{
+		// Files without a comparison (single-file groups, silence, mismatched sample rates) have no offset
+		const auto isCompared{ file.m_alignmentCorrelation >= 0.0f };
+		m_checker.m_numMisalignedFiles += (isCompared && file.m_alignmentOffset != 0) ? 1 : 0;
+		append({ file.m_file.getFileName().toStdString().c_str(),
+		         file.m_alignmentGroup.toRawUTF8(),
+		         file.m_alignmentReference.toRawUTF8(),
+		         isCompared ? std::to_string(file.m_alignmentOffset).c_str() : ltrl::nil,
+		         isCompared ? juce::String(file.m_alignmentOffsetTime.inSeconds() * 1000.0, 2).toRawUTF8() : ltrl::nil,
+		         isCompared ? juce::String(file.m_alignmentCorrelation, 3).toRawUTF8() : ltrl::nil },
+		       file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::DUPLICATE_FINDER:
+	{
+		if (file.m_numDuplicates == 0)
+		{
+			append({ file.m_file.getFileName().toStdString().c_str(), "0", ltrl::nil, ltrl::nil, ltrl::nil },
+			       file.m_file.getFullPathName());
+			break;
+		}
+
+		// Everything but the first file of each cluster could be removed
+		const auto isOriginal{ file.m_duplicateOriginal == file.m_file.getFullPathName() };
+		m_checker.m_numDuplicateFiles++;
+		m_checker.m_sizeSavingsBytes += isOriginal ? 0 : file.m_file.getSize();
+		append({ file.m_file.getFileName().toStdString().c_str(),
+		         std::to_string(file.m_numDuplicates).c_str(),
+		         juce::File(file.m_duplicateOf).getFileName().toRawUTF8(),
+		         juce::String(file.m_duplicateSimilarity, 3).toRawUTF8(),
+		         isOriginal ? "Yes" : "No" },
+		       file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::THRESHOLD_SWEEP:
+	{
+		std::vector<std::string> row{ file.m_file.getFileName().toStdString() };
+		for (const auto& result : file.m_sweep)
+		{
+			row.emplace_back((result.m_firstNonZeroSample >= 0) ? std::to_string(result.m_firstNonZeroSample) : ltrl::nil);
+			row.emplace_back((result.m_lastNonZeroSample >= 0) ? std::to_string(result.m_lastNonZeroSample) : ltrl::nil);
+		}
+		append(row, file.m_file.getFullPathName());
+		break;
+	}
+	case Checker::AnalysisMode::LOUDNESS_CHECKER:
+	{
+		// Files too short or too quiet to pass the gates have a true peak but no integrated loudness or range
+		const auto& loudness{ file.m_loudness };
+		const auto truePeak{ juce::Decibels::gainToDecibels(loudness.m_truePeak) };
+		m_numTruePeakFiles += (truePeak > s_maxTruePeak) ? 1 : 0;
+
+		juce::String deviation{ ltrl::nil };
+		if (loudness.m_integrated.has_value())
+		{
+			const auto difference{ *loudness.m_integrated - static_cast<float>(m_checker.m_loudnessTarget.val) };
+			m_numOffTargetFiles += (std::abs(difference) > s_loudnessTolerance) ? 1 : 0;
+			deviation = ((difference > 0.0f) ? "+" : "") + juce::String(difference, 1);
+		}
+
+		append({ file.m_file.getFileName().toStdString().c_str(),
+		         loudness.m_integrated.has_value() ? juce::String(*loudness.m_integrated, 1).toRawUTF8() : ltrl::nil,
+		         loudness.m_range.has_value() ? juce::String(*loudness.m_range, 1).toRawUTF8() : ltrl::nil,
+		         juce::String(truePeak, 1).toRawUTF8(),
+		         deviation.toRawUTF8() },
+		       file.m_file.getFullPathName());
+		break;
+	}
 	}
 }
 
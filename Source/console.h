@@ -27,14 +27,27 @@ namespace zero
 		Console(Checker& checker, const std::optional<juce::String>& csv = std::nullopt, int numItems = 0);
 
 		void print();
+		void printRows();
 
 		void printStats();
 		void printCsv();
+		void printProfile();
+
+		juce::var statsToVar() const;
+		void addStats(const juce::var& stats);
+		void setHeader(const std::vector<std::string>& header);
 
 		void promptProcess();
 		static bool promptContinue(std::string_view question);
 
+		// Where -c writes its output: .ndjson/.jsonl are kept, anything else is written as .csv
+		static juce::File getOutputFile(const juce::String& csv);
+
+		// Rows of fields from a .csv written by Console, honoring quoted fields
+		static std::vector<std::vector<std::string>> parseCsv(std::string_view text);
+
 		void append(const std::initializer_list<const char*>& row, const juce::String& fullPath = "");
+		void append(const std::vector<std::string>& row, const juce::String& fullPath = "");
 
 		void append(const zero::File& file);
 
@@ -45,9 +58,17 @@ namespace zero
 
 		samilton::ConsoleTable m_table{};
 		samilton::ConsoleTable m_stats{};
+		size_t m_numRows{ 0 };
+		std::vector<std::string> m_header{};
+		int m_numClippedFiles{ 0 };
+		int m_numSilentFiles{ 0 };
+		int m_numOffTargetFiles{ 0 };
+		int m_numTruePeakFiles{ 0 };
 
 		std::optional<juce::File> m_csvFile{};
 		std::optional<juce::String> m_csvText{};
+		bool m_csvStarted{ false };
+		bool m_ndjson{ false };
 
 		float m_progress{ 0.0f };
 		int m_progressBarWidth{ 70 };
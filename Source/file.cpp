@@ -10,12 +10,23 @@
 */
 
 #include "file.h"
+#include "analysis.h"
+#include "pyramid.h"
+#include "profiler.h"
+#include "silence.h"
+
+#include <atomic>
+#include <execution>
+#include <numeric>
 
 using namespace zero;
 
 namespace
 {
-	constexpr auto s_epsilon{ 0.0005f };
+	constexpr auto s_analysisBlockSize{ 16384 };
+	constexpr auto s_minLoopWindowSize{ 16 };
+	constexpr auto s_clickBandHz{ 2000.0 };
+	constexpr auto s_clickRiskRangeDb{ 20.0f };
 
 	enum class SearchDirection
 	{
@@ -51,7 +62,7 @@ namespace
 		{
 			auto numThisTime = (int) juce::jmin(std::abs(numSamplesToSearch), (juce::int64) bufferSize);
 			juce::int64 bufferStart = (searchDirection == SearchDirection::FORWARD) ?
-			                          startSample : startSample - bufferSize;
+			                          startSample : startSample - numThisTime;
 
 			if (numSamplesToSearch < 0)
 			{
@@ -63,7 +74,11 @@ namespace
 				break;
 			}
 
-			reader->read(&tempBuffer, 0, numThisTime, bufferStart, false, false);
+			{
+				Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+				reader->read(&tempBuffer, 0, numThisTime, bufferStart, false, false);
+			}
+			Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
 			auto num = numThisTime;
 
 			while (--num >= 0)
@@ -129,6 +144,343 @@ namespace
 
 		return -1;
 	}
+
+	// Where each direction starts searching and for how many samples, as passed to searchForLevel
+	struct SearchBounds
+	{
+		juce::int64 m_forwardOffset{ 0 };
+		juce::int64 m_numForwardSamples{ 0 };
+		juce::int64 m_reverseOffset{ 0 };
+		juce::int64 m_numReverseSamples{ 0 };
+	};
+
+	void skipSamples(juce::int64& offset, juce::int64& numSamples, juce::int64 numToSkip)
+	{
+		if (numSamples > 0 && offset < numToSkip)
+		{
+			numSamples = std::max(numSamples - (numToSkip - offset), static_cast<juce::int64>(0));
+			offset = numToSkip;
+		}
+	}
+
+	// Exact zeros can never reach a positive minimum, so digital silence at either end is skipped in the raw bytes
+	// before anything is decoded; a file that is silent throughout resolves without decoding at all
+	SearchBounds skipDigitalSilence(File& file, juce::AudioFormatReader& reader, juce::int64 startSampleOffset,
+	                                juce::int64 numSamplesToSearch, double magnitudeRangeMin)
+	{
+		if (numSamplesToSearch == -1)
+		{
+			numSamplesToSearch = reader.lengthInSamples;
+		}
+
+		SearchBounds bounds{ startSampleOffset, numSamplesToSearch, startSampleOffset, numSamplesToSearch };
+		file.m_isDigitalSilence = false;
+		if (magnitudeRangeMin <= 0.0 || file.m_file == juce::File() || reader.input == nullptr)
+		{
+			return bounds;
+		}
+
+		if (const auto silence{ DigitalSilence::scan(file.m_file, *reader.input) })
+		{
+			file.m_isDigitalSilence = silence->isSilent();
+			skipSamples(bounds.m_forwardOffset, bounds.m_numForwardSamples, silence->m_numLeadingSamples);
+			skipSamples(bounds.m_reverseOffset, bounds.m_numReverseSamples, silence->m_numTrailingSamples);
+		}
+		return bounds;
+	}
+
+	// searchForLevel for several configurations at once; each block is decoded once and the scan stops as soon as the
+	// last configuration finds its run. Results are written in place, in the same units as searchForLevel.
+	void searchForLevels(juce::AudioFormatReader& reader, SearchDirection searchDirection,
+	                     juce::Range<juce::int64> window, double magnitudeRangeMaximum, std::vector<SweepResult>& results)
+	{
+		struct Search
+		{
+			SweepResult* m_result{ nullptr };
+			juce::int64 m_required{ 1 };
+			juce::int64 m_consecutive{ 0 };
+			juce::int64 m_firstMatchPos{ -1 };
+		};
+
+		std::vector<Search> searches{};
+		for (auto& result : results)
+		{
+			searches.push_back({ &result, std::max(result.m_minConsecutiveSamples, 1) });
+		}
+
+		const auto forward{ searchDirection == SearchDirection::FORWARD };
+		const auto numChannels{ static_cast<int>(reader.numChannels) };
+		juce::AudioBuffer<float> buffer{ numChannels, s_analysisBlockSize };
+		for (auto numSearched{ static_cast<juce::int64>(0) }; numSearched < window.getLength() && !searches.empty();)
+		{
+			const auto numThisTime{ static_cast<int>(juce::jmin(window.getLength() - numSearched,
+			                                                    static_cast<juce::int64>(s_analysisBlockSize))) };
+			const auto blockStart{ forward ? window.getStart() + numSearched :
+			                       window.getEnd() - numSearched - numThisTime };
+			numSearched += numThisTime;
+			{
+				Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+				reader.read(&buffer, 0, numThisTime, blockStart, true, true);
+			}
+
+			Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+			for (auto num{ 0 }; num < numThisTime && !searches.empty(); ++num)
+			{
+				const auto index{ forward ? num : numThisTime - 1 - num };
+
+				// Loudest channel still under the maximum; a sample matches every minimum at or below it
+				auto level{ -1.0f };
+				for (auto ch{ 0 }; ch < numChannels; ++ch)
+				{
+					const auto smpl{ std::abs(buffer.getReadPointer(ch)[index]) };
+					if (smpl <= magnitudeRangeMaximum && smpl > level)
+					{
+						level = smpl;
+					}
+				}
+
+				// Reverse results count from the end of the file to one past the run, as searchForLevel does
+				const auto position{ blockStart + index };
+				for (auto it{ searches.begin() }; it != searches.end();)
+				{
+					if (level < 0.0f || level < it->m_result->m_magnitudeRangeMin)
+					{
+						it->m_consecutive = 0;
+						it->m_firstMatchPos = -1;
+						++it;
+						continue;
+					}
+
+					if (it->m_consecutive++ == 0)
+					{
+						it->m_firstMatchPos = forward ? position : position + 1;
+					}
+					if (it->m_consecutive < it->m_required)
+					{
+						++it;
+						continue;
+					}
+
+					auto& sample{ forward ? it->m_result->m_firstNonZeroSample : it->m_result->m_lastNonZeroSample };
+					sample = forward ? it->m_firstMatchPos : reader.lengthInSamples - it->m_firstMatchPos;
+					it = searches.erase(it);
+				}
+			}
+		}
+	}
+
+	// Feeds a range to an analyzer block by block; decoding can be skipped when the analyzer only counts samples
+	void analyzeRange(juce::AudioFormatReader& reader, juce::Range<juce::int64> range, Analyzer& analyzer, bool decode)
+	{
+		juce::AudioBuffer<float> buffer{ static_cast<int>(reader.numChannels), s_analysisBlockSize };
+		for (auto blockStart{ range.getStart() }; blockStart < range.getEnd(); blockStart += s_analysisBlockSize)
+		{
+			const auto numThisTime{ static_cast<int>(juce::jmin(range.getEnd() - blockStart,
+			                                                    static_cast<juce::int64>(s_analysisBlockSize))) };
+			if (decode)
+			{
+				Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+				reader.read(&buffer, 0, numThisTime, blockStart, true, true);
+			}
+
+			Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+			analyzer.process(buffer, blockStart, numThisTime);
+		}
+	}
+
+	// Mono compatibility reads to the end of the file when no sample count is given
+	SearchWindows getMonoWindows(juce::int64 lengthInSamples, juce::int64 startSampleOffset,
+	                             juce::int64 numSamplesToSearch)
+	{
+		return { lengthInSamples, startSampleOffset, (numSamplesToSearch > 0) ? numSamplesToSearch : -1 };
+	}
+
+	// Long windows are split into fixed-size chunks that can be decoded on separate threads with separate readers
+	std::vector<juce::Range<juce::int64>> splitIntoChunks(juce::Range<juce::int64> window)
+	{
+		std::vector<juce::Range<juce::int64>> chunks{};
+		for (auto start{ window.getStart() }; start < window.getEnd(); start += File::s_parallelChunkSize)
+		{
+			chunks.emplace_back(start, juce::jmin(start + File::s_parallelChunkSize, window.getEnd()));
+		}
+		return chunks;
+	}
+
+	template<typename Function>
+	void forEachChunk(size_t numChunks, Function&& function)
+	{
+		std::vector<size_t> steps(numChunks);
+		std::iota(steps.begin(), steps.end(), size_t{ 0 });
+
+		// Chunks run on other threads, so they join the calling thread's file explicitly
+		const auto profileFile{ Profiler::ScopedFile::current() };
+		const auto attributed{ [&](size_t step)
+		{
+			Profiler::ScopedFile::Attach attach{ profileFile };
+			function(step);
+		} };
+#if defined (JUCE_MAC)
+		std::for_each(steps.begin(), steps.end(), attributed);
+#else
+		std::for_each(std::execution::par, steps.begin(), steps.end(), attributed);
+#endif
+	}
+
+	// Level runs within one chunk, plus the matching samples at either edge so runs can be joined across chunks
+	struct ChunkRuns
+	{
+		juce::Range<juce::int64> m_range{};
+		juce::int64 m_prefix{ 0 };
+		juce::int64 m_suffix{ 0 };
+		juce::int64 m_firstRunStart{ -1 };
+		juce::int64 m_lastRunEnd{ -1 };
+		bool m_scanned{ false };
+	};
+
+	void scanChunk(juce::AudioFormatReader& reader, ChunkRuns& chunk, float magnitudeRangeMin, float magnitudeRangeMax,
+	               int minConsecutiveSamples)
+	{
+		LevelRun run{ minConsecutiveSamples };
+		auto inPrefix{ true };
+		juce::AudioBuffer<float> buffer{ static_cast<int>(reader.numChannels), s_analysisBlockSize };
+		const auto& range{ chunk.m_range };
+		for (auto blockStart{ range.getStart() }; blockStart < range.getEnd(); blockStart += s_analysisBlockSize)
+		{
+			const auto numThisTime{ static_cast<int>(juce::jmin(range.getEnd() - blockStart,
+			                                                    static_cast<juce::int64>(s_analysisBlockSize))) };
+			{
+				Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+				reader.read(&buffer, 0, numThisTime, blockStart, true, true);
+			}
+
+			Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+			for (auto index{ 0 }; index < numThisTime; ++index)
+			{
+				auto matches{ false };
+				for (auto ch{ 0 }; ch < buffer.getNumChannels() && !matches; ++ch)
+				{
+					const auto smpl{ std::abs(buffer.getReadPointer(ch)[index]) };
+					matches = smpl >= magnitudeRangeMin && smpl <= magnitudeRangeMax;
+				}
+
+				run.push(blockStart + index, matches);
+				inPrefix = inPrefix && matches;
+				chunk.m_prefix += inPrefix ? 1 : 0;
+			}
+		}
+
+		chunk.m_suffix = run.m_runLength;
+		chunk.m_firstRunStart = run.m_firstRunStart;
+		chunk.m_lastRunEnd = run.m_lastRunEnd;
+		chunk.m_scanned = true;
+	}
+
+	// Replays consecutive chunk summaries as if the whole span had been pushed through one LevelRun
+	LevelRun joinChunks(const std::vector<ChunkRuns>& chunks, size_t first, size_t last, int minConsecutiveSamples)
+	{
+		LevelRun joined{ minConsecutiveSamples };
+		const auto required{ static_cast<juce::int64>(joined.m_minConsecutiveSamples) };
+		for (auto index{ first }; index <= last; ++index)
+		{
+			const auto& chunk{ chunks[index] };
+
+			// Leading matches extend the run carried over from earlier chunks
+			if (chunk.m_prefix > 0)
+			{
+				if (joined.m_runLength == 0)
+				{
+					joined.m_runStart = chunk.m_range.getStart();
+				}
+				joined.m_runLength += chunk.m_prefix;
+				if (joined.m_runLength >= required)
+				{
+					if (joined.m_firstRunStart < 0)
+					{
+						joined.m_firstRunStart = joined.m_runStart;
+					}
+					joined.m_lastRunEnd = chunk.m_range.getStart() + chunk.m_prefix;
+				}
+			}
+			if (chunk.m_prefix == chunk.m_range.getLength())
+			{
+				continue;
+			}
+
+			// Runs inside the chunk are complete; only the trailing one may continue into the next chunk
+			if (joined.m_firstRunStart < 0)
+			{
+				joined.m_firstRunStart = chunk.m_firstRunStart;
+			}
+			joined.m_lastRunEnd = std::max(joined.m_lastRunEnd, chunk.m_lastRunEnd);
+			joined.m_runStart = chunk.m_range.getEnd() - chunk.m_suffix;
+			joined.m_runLength = chunk.m_suffix;
+		}
+		return joined;
+	}
+
+	// Scans chunks on all cores in order of distance from where the search starts. Once a chunk holds a complete run
+	// on its own, chunks further away can't change the answer and are skipped; at most one per core is wasted.
+	// Returns the index of the deciding chunk, or the furthest chunk if none decides; -1 if a reader couldn't be made.
+	int scanSpeculatively(std::vector<ChunkRuns>& chunks, bool reverse, const File::ReaderFactory& createReader,
+	                      float magnitudeRangeMin, float magnitudeRangeMax, int minConsecutiveSamples)
+	{
+		std::atomic<size_t> decidingStep{ chunks.size() };
+		forEachChunk(chunks.size(), [&](size_t step)
+		{
+			if (step > decidingStep.load())
+			{
+				return;
+			}
+
+			auto& chunk{ chunks[reverse ? chunks.size() - 1 - step : step] };
+			if (auto reader = createReader())
+			{
+				scanChunk(*reader, chunk, magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
+			}
+
+			if ((reverse ? chunk.m_lastRunEnd : chunk.m_firstRunStart) >= 0)
+			{
+				auto current{ decidingStep.load() };
+				while (step < current && !decidingStep.compare_exchange_weak(current, step)) { }
+			}
+		});
+
+		const auto lastStep{ std::min(decidingStep.load(), chunks.size() - 1) };
+		for (size_t step{ 0 }; step <= lastStep; ++step)
+		{
+			if (!chunks[reverse ? chunks.size() - 1 - step : step].m_scanned)
+			{
+				return -1;
+			}
+		}
+		return static_cast<int>(reverse ? chunks.size() - 1 - lastStep : lastStep);
+	}
+
+	// Magnitude spectrum of a Hann-windowed frame of fft size samples
+	std::vector<float> magnitudeSpectrum(const juce::dsp::FFT& fft, const float* samples)
+	{
+		const auto fftSize{ static_cast<size_t>(fft.getSize()) };
+		std::vector<float> frame(fftSize * 2, 0.0f);
+		std::copy(samples, samples + fftSize, frame.begin());
+
+		juce::dsp::WindowingFunction<float>::fillWindowingTables(frame.data() + fftSize, fftSize,
+		                                                         juce::dsp::WindowingFunction<float>::hann, false);
+		juce::FloatVectorOperations::multiply(frame.data(), frame.data() + fftSize, static_cast<int>(fftSize));
+		fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+		frame.resize(fftSize / 2 + 1);
+		return frame;
+	}
+
+	float bandEnergy(const std::vector<float>& spectrum, size_t firstBin)
+	{
+		auto energy{ 0.0f };
+		for (auto bin{ firstBin }; bin < spectrum.size(); ++bin)
+		{
+			energy += spectrum[bin] * spectrum[bin];
+		}
+		return energy;
+	}
 }
 
 //==============================================================================
@@ -142,14 +494,140 @@ void File::calculate(juce::AudioFormatReader* reader, juce::int64 startSampleOff
 		numSamplesToSearch = reader->lengthInSamples;
 	}
 
-	m_firstNonZeroSample = searchForLevel(reader, SearchDirection::FORWARD, startSampleOffset, numSamplesToSearch,
+	const auto bounds{ skipDigitalSilence(*this, *reader, startSampleOffset, numSamplesToSearch, magnitudeRangeMin) };
+	search(reader, bounds.m_forwardOffset, bounds.m_numForwardSamples, bounds.m_reverseOffset,
+	       bounds.m_numReverseSamples, magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
+}
+
+void File::search(juce::AudioFormatReader* reader, juce::int64 forwardOffset, juce::int64 numForwardSamples,
+                  juce::int64 reverseOffset, juce::int64 numReverseSamples, double magnitudeRangeMin,
+                  double magnitudeRangeMax, int minConsecutiveSamples)
+{
+	m_firstNonZeroSample = searchForLevel(reader, SearchDirection::FORWARD, forwardOffset, numForwardSamples,
 	                                      magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
 	m_firstNonZeroTime = juce::RelativeTime(static_cast<double>(m_firstNonZeroSample) / reader->sampleRate);
-	m_lastNonZeroSample = searchForLevel(reader, SearchDirection::REVERSE, startSampleOffset, numSamplesToSearch,
+	m_lastNonZeroSample = searchForLevel(reader, SearchDirection::REVERSE, reverseOffset, numReverseSamples,
 	                                     magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
 	m_lastNonZeroTime = juce::RelativeTime(static_cast<double>(m_lastNonZeroSample) / reader->sampleRate);
 }
 
+void File::calculate(juce::AudioFormatReader* reader, const ReaderFactory& createReader,
+                     juce::int64 startSampleOffset, juce::int64 numSamplesToSearch, double magnitudeRangeMin,
+                     double magnitudeRangeMax, int minConsecutiveSamples)
+{
+	const auto length{ reader->lengthInSamples };
+	const auto bounds{ skipDigitalSilence(*this, *reader, startSampleOffset, numSamplesToSearch, magnitudeRangeMin) };
+	auto searchSerially = [&]
+	{
+		search(reader, bounds.m_forwardOffset, bounds.m_numForwardSamples, bounds.m_reverseOffset,
+		       bounds.m_numReverseSamples, magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
+	};
+
+	auto forward{ splitIntoChunks(SearchWindows{ length, bounds.m_forwardOffset, bounds.m_numForwardSamples }.m_forward) };
+	auto reverse{ splitIntoChunks(SearchWindows{ length, bounds.m_reverseOffset, bounds.m_numReverseSamples }.m_reverse) };
+	if (forward.size() < static_cast<size_t>(File::s_minParallelChunks) || reverse.empty())
+	{
+		searchSerially();
+		return;
+	}
+
+	auto toRuns = [](const std::vector<juce::Range<juce::int64>>& ranges)
+	{
+		std::vector<ChunkRuns> runs(ranges.size());
+		for (size_t index{ 0 }; index < ranges.size(); ++index)
+		{
+			runs[index].m_range = ranges[index];
+		}
+		return runs;
+	};
+	auto forwardRuns{ toRuns(forward) };
+	auto reverseRuns{ toRuns(reverse) };
+
+	const auto min{ static_cast<float>(magnitudeRangeMin) };
+	const auto max{ static_cast<float>(magnitudeRangeMax) };
+	const auto lastForward{ scanSpeculatively(forwardRuns, false, createReader, min, max, minConsecutiveSamples) };
+	const auto firstReverse{ scanSpeculatively(reverseRuns, true, createReader, min, max, minConsecutiveSamples) };
+	if (lastForward < 0 || firstReverse < 0)
+	{
+		searchSerially();
+		return;
+	}
+
+	// Same answers as the serial search: earliest run start going forward, latest run end going in reverse
+	const auto first{ joinChunks(forwardRuns, 0, static_cast<size_t>(lastForward), minConsecutiveSamples) };
+	const auto last{ joinChunks(reverseRuns, static_cast<size_t>(firstReverse), reverseRuns.size() - 1,
+	                            minConsecutiveSamples) };
+	m_firstNonZeroSample = first.m_firstRunStart;
+	m_firstNonZeroTime = juce::RelativeTime(static_cast<double>(m_firstNonZeroSample) / reader->sampleRate);
+	m_lastNonZeroSample = (last.m_lastRunEnd < 0) ? -1 : reader->lengthInSamples - last.m_lastRunEnd;
+	m_lastNonZeroTime = juce::RelativeTime(static_cast<double>(m_lastNonZeroSample) / reader->sampleRate);
+}
+
+void File::calculate(juce::AudioFormatReader* reader, const PeakPyramid& pyramid, juce::int64 startSampleOffset,
+                     juce::int64 numSamplesToSearch, double magnitudeRangeMin, double magnitudeRangeMax,
+                     int minConsecutiveSamples)
+{
+	const SearchWindows windows{ reader->lengthInSamples, startSampleOffset, numSamplesToSearch };
+	const auto min{ static_cast<float>(magnitudeRangeMin) };
+	const auto max{ static_cast<float>(magnitudeRangeMax) };
+
+	m_firstNonZeroSample = pyramid.searchForward(reader, windows.m_forward, min, max, minConsecutiveSamples);
+	m_firstNonZeroTime = juce::RelativeTime(static_cast<double>(m_firstNonZeroSample) / reader->sampleRate);
+	m_lastNonZeroSample = pyramid.searchReverse(reader, windows.m_reverse, min, max, minConsecutiveSamples);
+	m_lastNonZeroTime = juce::RelativeTime(static_cast<double>(m_lastNonZeroSample) / reader->sampleRate);
+}
+
+void File::analyze(juce::AudioFormatReader* reader, juce::int64 startSampleOffset, juce::int64 numSamplesToSearch,
+                   const std::vector<std::unique_ptr<Analyzer>>& analyzers)
+{
+	const SearchWindows windows{ reader->lengthInSamples, startSampleOffset, numSamplesToSearch };
+	for (const auto& analyzer : analyzers)
+	{
+		analyzer->prepare(*reader, windows);
+	}
+
+	// Decode the forward window once, handing every block to all analyzers, plus the reverse window if one needs it
+	const auto needsReverse{ std::any_of(analyzers.begin(), analyzers.end(), [](const auto& analyzer)
+	{
+		return analyzer->needsReverseWindow();
+	}) };
+	std::vector<juce::Range<juce::int64>> regions{ windows.m_forward };
+	if (needsReverse && windows.m_reverse.getStart() <= windows.m_forward.getEnd() &&
+	    windows.m_reverse.getEnd() >= windows.m_forward.getStart())
+	{
+		regions.front() = windows.m_forward.getUnionWith(windows.m_reverse);
+	}
+	else if (needsReverse)
+	{
+		regions.push_back(windows.m_reverse);
+	}
+
+	juce::AudioBuffer<float> buffer{ static_cast<int>(reader->numChannels), s_analysisBlockSize };
+	for (const auto& region : regions)
+	{
+		for (auto blockStart{ region.getStart() }; blockStart < region.getEnd(); blockStart += s_analysisBlockSize)
+		{
+			const auto numThisTime{ static_cast<int>(juce::jmin(region.getEnd() - blockStart,
+			                                                    static_cast<juce::int64>(s_analysisBlockSize))) };
+			{
+				Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+				reader->read(&buffer, 0, numThisTime, blockStart, true, true);
+			}
+
+			Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+			for (const auto& analyzer : analyzers)
+			{
+				analyzer->process(buffer, blockStart, numThisTime);
+			}
+		}
+	}
+
+	for (const auto& analyzer : analyzers)
+	{
+		analyzer->finish(*this);
+	}
+}
+
 juce::String File::relTimeToString(const juce::RelativeTime& t)
 {
 	auto str{ juce::String(t.inSeconds()) };
@@ -159,45 +637,163 @@ juce::String File::relTimeToString(const juce::RelativeTime& t)
 	return ((prd > -1) ? str.substring(0, prd + 4) : str);
 }
 
-void zero::File::calculateMonoCompatibility(juce::AudioFormatReader* reader, juce::int64 startSampleOffset,
-                                            juce::int64 numSamplesToSearch)
+void File::calculateSweep(juce::AudioFormatReader* reader, juce::int64 startSampleOffset,
+                          juce::int64 numSamplesToSearch, const std::vector<double>& magnitudeRangeMins,
+                          double magnitudeRangeMax, const std::vector<int>& minConsecutiveSamples)
 {
-	m_numChannels = static_cast<int>(reader->numChannels);
-	m_numSamples = static_cast<int>((numSamplesToSearch > 0) ? numSamplesToSearch : reader->lengthInSamples);
-	const auto compatibilityIncr{ 1.0f / static_cast<float>(m_numSamples) };
+	m_sweep.clear();
+	for (const auto min : magnitudeRangeMins)
+	{
+		for (const auto consec : minConsecutiveSamples)
+		{
+			m_sweep.push_back({ min, consec });
+		}
+	}
 
-	if (m_numChannels == 1)
+	if (m_sweep.empty())
 	{
-		m_monoCompatibility = -1.0f;
 		return;
 	}
 
-	juce::AudioSampleBuffer buffer{ m_numChannels, m_numSamples };
-	reader->read(&buffer, 0, m_numSamples, startSampleOffset, true, true);
+	// Silence can only be skipped when it misses every minimum
+	const auto length{ reader->lengthInSamples };
+	const auto lowestMin{ *std::min_element(magnitudeRangeMins.begin(), magnitudeRangeMins.end()) };
+	const auto bounds{ skipDigitalSilence(*this, *reader, startSampleOffset, numSamplesToSearch, lowestMin) };
+	searchForLevels(*reader, SearchDirection::FORWARD,
+	                SearchWindows{ length, bounds.m_forwardOffset, bounds.m_numForwardSamples }.m_forward,
+	                magnitudeRangeMax, m_sweep);
+	searchForLevels(*reader, SearchDirection::REVERSE,
+	                SearchWindows{ length, bounds.m_reverseOffset, bounds.m_numReverseSamples }.m_reverse,
+	                magnitudeRangeMax, m_sweep);
+}
 
-	std::vector<float> sampleBuffer;
-	for (auto sample{ 0 }; sample < m_numSamples; ++sample)
+void zero::File::calculateMonoCompatibility(juce::AudioFormatReader* reader, juce::int64 startSampleOffset,
+                                            juce::int64 numSamplesToSearch)
+{
+	const auto windows{ getMonoWindows(reader->lengthInSamples, startSampleOffset, numSamplesToSearch) };
+
+	// Streamed block by block so multi-hour files never need a whole-file buffer; mono files skip decoding entirely
+	MonoAnalyzer analyzer;
+	analyzer.prepare(*reader, windows);
+	analyzeRange(*reader, windows.m_forward, analyzer, reader->numChannels > 1);
+	analyzer.finish(*this);
+}
+
+void File::calculateMonoCompatibility(juce::AudioFormatReader* reader, const ReaderFactory& createReader,
+                                      juce::int64 startSampleOffset, juce::int64 numSamplesToSearch)
+{
+	const auto windows{ getMonoWindows(reader->lengthInSamples, startSampleOffset, numSamplesToSearch) };
+	const auto chunks{ splitIntoChunks(windows.m_forward) };
+	if (reader->numChannels < 2 || chunks.size() < static_cast<size_t>(File::s_minParallelChunks))
 	{
-		sampleBuffer.clear();
-		sampleBuffer.reserve(m_numChannels);
+		calculateMonoCompatibility(reader, startSampleOffset, numSamplesToSearch);
+		return;
+	}
 
-		for (auto channel{ 0 }; channel < m_numChannels; ++channel)
+	// Each chunk counts on its own reader, and the counts are summed at the end
+	std::vector<MonoAnalyzer> analyzers(chunks.size());
+	std::atomic<bool> failed{ false };
+	forEachChunk(chunks.size(), [&](size_t index)
+	{
+		if (auto chunkReader = createReader())
 		{
-			auto channelData{ buffer.getReadPointer(channel) };
-			sampleBuffer.emplace_back(channelData[sample]);
+			analyzers[index].prepare(*chunkReader, windows);
+			analyzeRange(*chunkReader, chunks[index], analyzers[index], true);
 		}
-
-		// Check if all channels are equal to the first element
-		auto equalsFirstSample = [&sampleBuffer](float f)
+		else
 		{
-			return std::abs(f - sampleBuffer[0]) < s_epsilon;
-		};
+			failed = true;
+		}
+	});
+
+	if (failed)
+	{
+		calculateMonoCompatibility(reader, startSampleOffset, numSamplesToSearch);
+		return;
+	}
+
+	MonoAnalyzer total;
+	total.prepare(*reader, windows);
+	for (const auto& analyzer : analyzers)
+	{
+		total.merge(analyzer);
+	}
+	total.finish(*this);
+}
+
+void File::calculateLoopClickRisk(juce::AudioFormatReader* reader, int windowSize)
+{
+	m_loopSeam = {};
+
+	// Only the head and tail windows are read, so cost does not depend on file length
+	const auto maxWindowSize{ static_cast<int>(juce::jmin(reader->lengthInSamples / 2,
+	                                                      static_cast<juce::int64>(std::max(windowSize, 1)))) };
+	if (maxWindowSize < s_minLoopWindowSize)
+	{
+		return;
+	}
+
+	auto order{ 0 };
+	while ((2 << order) <= maxWindowSize)
+	{
+		++order;
+	}
+	const auto fftSize{ 1 << order };
+	const auto halfSize{ fftSize / 2 };
+	m_loopSeam.m_windowSize = fftSize;
+
+	const auto numChannels{ static_cast<int>(reader->numChannels) };
+	juce::AudioBuffer<float> head{ numChannels, fftSize };
+	juce::AudioBuffer<float> tail{ numChannels, fftSize };
+	{
+		Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+		reader->read(&head, 0, fftSize, 0, true, true);
+		reader->read(&tail, 0, fftSize, reader->lengthInSamples - fftSize, true, true);
+	}
+
+	Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+	const juce::dsp::FFT fft{ order };
+	const auto firstClickBin{ static_cast<size_t>(juce::jlimit(1, halfSize, static_cast<int>(
+			s_clickBandHz * fftSize / reader->sampleRate))) };
+	std::vector<float> seam(static_cast<size_t>(fftSize));
+
+	// Worst channel wins for every metric
+	for (auto ch{ 0 }; ch < numChannels; ++ch)
+	{
+		const auto h{ head.getReadPointer(ch) };
+		const auto t{ tail.getReadPointer(ch) };
+
+		// Step and change of slope between last and first samples
+		m_loopSeam.m_amplitudeJump = std::max(m_loopSeam.m_amplitudeJump, std::abs(h[0] - t[fftSize - 1]));
+		m_loopSeam.m_slopeJump = std::max(m_loopSeam.m_slopeJump,
+		                                  std::abs((h[1] - h[0]) - (t[fftSize - 1] - t[fftSize - 2])));
+
+		const auto headSpectrum{ magnitudeSpectrum(fft, h) };
+		const auto tailSpectrum{ magnitudeSpectrum(fft, t) };
+
+		// Window straddling the seam, as heard when the loop wraps around
+		std::copy(t + halfSize, t + fftSize, seam.begin());
+		std::copy(h, h + halfSize, seam.begin() + halfSize);
+		const auto seamSpectrum{ magnitudeSpectrum(fft, seam.data()) };
 
-		if (std::all_of(sampleBuffer.begin() + 1, sampleBuffer.end(), equalsFirstSample))
+		// RMS difference of log spectra on either side of the seam
+		auto sumOfSquares{ 0.0f };
+		for (size_t bin{ 1 }; bin < headSpectrum.size(); ++bin)
 		{
-			m_monoCompatibility += compatibilityIncr;
+			const auto diff{ juce::Decibels::gainToDecibels(headSpectrum[bin] + 1.0e-9f) -
+			                 juce::Decibels::gainToDecibels(tailSpectrum[bin] + 1.0e-9f) };
+			sumOfSquares += diff * diff;
 		}
+		m_loopSeam.m_spectralDistance = std::max(m_loopSeam.m_spectralDistance, std::sqrt(
+				sumOfSquares / static_cast<float>(headSpectrum.size() - 1)));
+
+		// A click spreads broadband energy, so compare high band energy across the seam to either side
+		const auto seamEnergy{ bandEnergy(seamSpectrum, firstClickBin) };
+		const auto sideEnergy{ 0.5f * (bandEnergy(headSpectrum, firstClickBin) +
+		                               bandEnergy(tailSpectrum, firstClickBin)) };
+		m_loopSeam.m_seamExcess = std::max(m_loopSeam.m_seamExcess, 10.0f * std::log10(
+				(seamEnergy + 1.0e-12f) / (sideEnergy + 1.0e-12f)));
 	}
 
-	m_monoCompatibility = std::min(m_monoCompatibility, 1.0f);
+	m_loopSeam.m_clickRisk = juce::jlimit(0.0f, 1.0f, m_loopSeam.m_seamExcess / s_clickRiskRangeDb);
 }
\ No newline at end of file
@@ -13,10 +13,49 @@
 
 #include <JuceHeader.h>
 
+#include <functional>
+#include <optional>
+
 namespace zero
 {
+	class Analyzer;
+	class PeakPyramid;
+
+	// Discontinuity and spectral mismatch across the seam of a looping file
+	struct LoopSeam
+	{
+		int m_windowSize{ 0 };
+		float m_amplitudeJump{ 0.0f };
+		float m_slopeJump{ 0.0f };
+		float m_spectralDistance{ 0.0f };
+		float m_seamExcess{ 0.0f };
+		float m_clickRisk{ -1.0f };
+	};
+
+	// First and last non-zero samples for one --min/--consec combination of a threshold sweep
+	struct SweepResult
+	{
+		double m_magnitudeRangeMin{ 0.0 };
+		int m_minConsecutiveSamples{ 0 };
+		juce::int64 m_firstNonZeroSample{ -1 };
+		juce::int64 m_lastNonZeroSample{ -1 };
+	};
+
+	// EBU R128 loudness of the searched window; integrated needs 400 ms and range 3 s above the -70 LUFS gate
+	struct Loudness
+	{
+		std::optional<float> m_integrated{}; // LUFS
+		std::optional<float> m_range{};      // LU
+		float m_truePeak{ 0.0f };            // Gain, like m_peak
+	};
+
 	struct File
 	{
+		// Opens another reader on the same file, so chunks of one long file can be decoded on several threads
+		using ReaderFactory = std::function<std::unique_ptr<juce::AudioFormatReader>()>;
+		static constexpr juce::int64 s_parallelChunkSize{ 1 << 20 };
+		static constexpr auto s_minParallelChunks{ 4 };
+
 		explicit File(juce::File file);
 
 		juce::File m_file{};
@@ -26,14 +65,59 @@ namespace zero
 		juce::RelativeTime m_lastNonZeroTime{};
 		float m_monoCompatibility{ 0.0f };
 		int m_numChannels{ 0 };
-		int m_numSamples{ 0 };
+		juce::int64 m_numSamples{ 0 };
+		float m_peak{ 0.0f };
+		float m_rms{ 0.0f };
+		float m_dcOffset{ 0.0f };
+		juce::int64 m_numClippedSamples{ 0 };
+		LoopSeam m_loopSeam{};
+		std::vector<juce::Range<juce::int64>> m_regions{};
+		juce::RelativeTime m_longestGap{};
+		juce::String m_alignmentGroup{};
+		juce::String m_alignmentReference{};
+		juce::int64 m_alignmentOffset{ 0 };
+		juce::RelativeTime m_alignmentOffsetTime{};
+		float m_alignmentCorrelation{ -1.0f };
+		std::vector<juce::uint32> m_fingerprint{};
+		juce::String m_duplicateOf{};
+		juce::String m_duplicateOriginal{};
+		float m_duplicateSimilarity{ -1.0f };
+		int m_numDuplicates{ 0 };
+		std::vector<SweepResult> m_sweep{};
+		bool m_isDigitalSilence{ false };
+		Loudness m_loudness{};
 
 		void calculate(juce::AudioFormatReader* reader, juce::int64 startSampleOffset, juce::int64 numSamplesToSearch,
 		               double magnitudeRangeMin, double magnitudeRangeMax, int minConsecutiveSamples);
 
+		void search(juce::AudioFormatReader* reader, juce::int64 forwardOffset, juce::int64 numForwardSamples,
+		            juce::int64 reverseOffset, juce::int64 numReverseSamples, double magnitudeRangeMin,
+		            double magnitudeRangeMax, int minConsecutiveSamples);
+
+		void calculate(juce::AudioFormatReader* reader, const ReaderFactory& createReader,
+		               juce::int64 startSampleOffset, juce::int64 numSamplesToSearch, double magnitudeRangeMin,
+		               double magnitudeRangeMax, int minConsecutiveSamples);
+
+		void calculate(juce::AudioFormatReader* reader, const PeakPyramid& pyramid, juce::int64 startSampleOffset,
+		               juce::int64 numSamplesToSearch, double magnitudeRangeMin, double magnitudeRangeMax,
+		               int minConsecutiveSamples);
+
+		// Every combination of minimum and consecutive count from one decode of each searched block
+		void calculateSweep(juce::AudioFormatReader* reader, juce::int64 startSampleOffset,
+		                    juce::int64 numSamplesToSearch, const std::vector<double>& magnitudeRangeMins,
+		                    double magnitudeRangeMax, const std::vector<int>& minConsecutiveSamples);
+
 		void calculateMonoCompatibility(juce::AudioFormatReader* reader, juce::int64 startSampleOffset,
 		                                juce::int64 numSamplesToSearch);
 
+		void calculateMonoCompatibility(juce::AudioFormatReader* reader, const ReaderFactory& createReader,
+		                                juce::int64 startSampleOffset, juce::int64 numSamplesToSearch);
+
+		void calculateLoopClickRisk(juce::AudioFormatReader* reader, int windowSize);
+
+		void analyze(juce::AudioFormatReader* reader, juce::int64 startSampleOffset, juce::int64 numSamplesToSearch,
+		             const std::vector<std::unique_ptr<Analyzer>>& analyzers);
+
 		static juce::String relTimeToString(const juce::RelativeTime& t);
 	};
 }
\ No newline at end of file
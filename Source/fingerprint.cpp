@@ -0,0 +1,423 @@
+/*
+  ==============================================================================
+
+    fingerprint.cpp
+    Created: 19 Oct 2026 3:40:20pm
+    Author:  Aaron Cendan
+    Description: Spectral fingerprints and an on-disk LSH index for near-duplicate detection
+
+  ==============================================================================
+*/
+
+#include "fingerprint.h"
+#include "file.h"
+#include "profiler.h"
+
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_frameSeconds{ 0.186 };
+	constexpr auto s_hopsPerFrame{ 16 };
+	constexpr auto s_numBands{ 33 };
+	constexpr auto s_minBandHz{ 300.0 };
+	constexpr auto s_maxBandHz{ 2000.0 };
+	constexpr auto s_silenceThreshold{ 0.001f };
+	constexpr auto s_minSubFingerprints{ 16 };
+
+	// LSH banding; 16 bands of 4 rows catch pairs from roughly 50% estimated similarity upwards
+	constexpr auto s_numBandsLsh{ 16 };
+	constexpr auto s_rowsPerBand{ FingerprintAnalyzer::s_numHashes / s_numBandsLsh };
+	constexpr auto s_maxBucketSize{ 1024 };
+
+	constexpr juce::uint32 s_indexMagic{ 0x5a465049 }; // "ZFPI"
+	constexpr auto s_indexVersion{ 2 };
+
+	juce::uint32 minHash(juce::uint32 value, int seed)
+	{
+		auto x{ static_cast<juce::uint64>(value) ^ (static_cast<juce::uint64>(seed + 1) * 0x9e3779b97f4a7c15ull) };
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdull;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ull;
+		x ^= x >> 33;
+		return static_cast<juce::uint32>(x);
+	}
+
+	juce::uint64 bandKey(const Signature& signature, int band)
+	{
+		auto hash{ 0xcbf29ce484222325ull ^ static_cast<juce::uint64>(band) };
+		for (auto row{ band * s_rowsPerBand }; row < (band + 1) * s_rowsPerBand; ++row)
+		{
+			hash = (hash ^ signature[static_cast<size_t>(row)]) * 0x100000001b3ull;
+		}
+		return hash;
+	}
+
+	float similarity(const Signature& a, const Signature& b)
+	{
+		auto numEqual{ 0 };
+		for (size_t index{ 0 }; index < a.size(); ++index)
+		{
+			numEqual += (a[index] == b[index]) ? 1 : 0;
+		}
+		return static_cast<float>(numEqual) / static_cast<float>(a.size());
+	}
+
+	size_t findRoot(std::vector<size_t>& parents, size_t index)
+	{
+		while (parents[index] != index)
+		{
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	}
+}
+
+void FingerprintAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	// Frame length is fixed in time, so the same sound at different sample rates lands on similar bands
+	const auto order{ juce::jlimit(8, 15, static_cast<int>(std::round(std::log2(reader.sampleRate * s_frameSeconds)))) };
+	m_fft = std::make_unique<juce::dsp::FFT>(order);
+	m_frameSize = 1 << order;
+	m_hopSize = m_frameSize / s_hopsPerFrame;
+	m_window = windows.m_forward;
+
+	m_fifo.assign(static_cast<size_t>(m_frameSize), 0.0f);
+	m_fifoFill = 0;
+	m_windowTable.assign(static_cast<size_t>(m_frameSize), 0.0f);
+	juce::dsp::WindowingFunction<float>::fillWindowingTables(m_windowTable.data(), static_cast<size_t>(m_frameSize),
+	                                                         juce::dsp::WindowingFunction<float>::hann, false);
+	m_fftData.assign(static_cast<size_t>(m_frameSize) * 2, 0.0f);
+
+	// Log-spaced band edges in bins, each band at least one bin wide
+	m_bandEdges.resize(s_numBands + 1);
+	const auto binsPerHz{ static_cast<double>(m_frameSize) / reader.sampleRate };
+	for (auto edge{ 0 }; edge <= s_numBands; ++edge)
+	{
+		const auto hz{ s_minBandHz * std::pow(s_maxBandHz / s_minBandHz, static_cast<double>(edge) / s_numBands) };
+		m_bandEdges[static_cast<size_t>(edge)] = static_cast<int>(std::round(hz * binsPerHz));
+		if (edge > 0)
+		{
+			m_bandEdges[static_cast<size_t>(edge)] = std::max(m_bandEdges[static_cast<size_t>(edge)],
+			                                                  m_bandEdges[static_cast<size_t>(edge - 1)] + 1);
+		}
+	}
+	m_energies.assign(s_numBands, 0.0f);
+	m_previousEnergies.assign(s_numBands, 0.0f);
+	m_hasPrevious = false;
+
+	m_signature.assign(s_numHashes, std::numeric_limits<juce::uint32>::max());
+	m_numSubFingerprints = 0;
+}
+
+void FingerprintAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	// Only the forward window contributes, as the reverse window may overlap it out of order
+	const auto range{ m_window.getIntersectionWith({ blockStart, blockStart + numSamples }) };
+	auto offset{ static_cast<int>(range.getStart() - blockStart) };
+	auto remaining{ static_cast<int>(range.getLength()) };
+
+	while (remaining > 0)
+	{
+		// Mono sum; the overall gain does not matter since only energy differences are compared
+		const auto numThisTime{ std::min(remaining, m_frameSize - m_fifoFill) };
+		const auto destination{ m_fifo.data() + m_fifoFill };
+		juce::FloatVectorOperations::copy(destination, block.getReadPointer(0, offset), numThisTime);
+		for (auto ch{ 1 }; ch < block.getNumChannels(); ++ch)
+		{
+			juce::FloatVectorOperations::add(destination, block.getReadPointer(ch, offset), numThisTime);
+		}
+
+		m_fifoFill += numThisTime;
+		offset += numThisTime;
+		remaining -= numThisTime;
+
+		if (m_fifoFill == m_frameSize)
+		{
+			processFrame();
+			std::copy(m_fifo.begin() + m_hopSize, m_fifo.end(), m_fifo.begin());
+			m_fifoFill -= m_hopSize;
+		}
+	}
+}
+
+void FingerprintAnalyzer::processFrame()
+{
+	const auto range{ juce::FloatVectorOperations::findMinAndMax(m_fifo.data(), m_frameSize) };
+	if (std::max(std::abs(range.getStart()), std::abs(range.getEnd())) < s_silenceThreshold)
+	{
+		m_hasPrevious = false;
+		return;
+	}
+
+	juce::FloatVectorOperations::multiply(m_fftData.data(), m_fifo.data(), m_windowTable.data(), m_frameSize);
+	m_fft->performFrequencyOnlyForwardTransform(m_fftData.data(), true);
+
+	for (auto band{ 0 }; band < s_numBands; ++band)
+	{
+		auto energy{ 0.0f };
+		const auto lastBin{ std::min(m_bandEdges[static_cast<size_t>(band + 1)], m_frameSize / 2) };
+		for (auto bin{ m_bandEdges[static_cast<size_t>(band)] }; bin < lastBin; ++bin)
+		{
+			energy += m_fftData[static_cast<size_t>(bin)] * m_fftData[static_cast<size_t>(bin)];
+		}
+		m_energies[static_cast<size_t>(band)] = energy;
+	}
+
+	if (m_hasPrevious)
+	{
+		juce::uint32 subFingerprint{ 0 };
+		for (auto bit{ 0 }; bit < s_numBands - 1; ++bit)
+		{
+			const auto index{ static_cast<size_t>(bit) };
+			const auto difference{ (m_energies[index] - m_energies[index + 1]) -
+			                       (m_previousEnergies[index] - m_previousEnergies[index + 1]) };
+			subFingerprint |= (difference > 0.0f) ? (1u << bit) : 0u;
+		}
+
+		for (auto hash{ 0 }; hash < s_numHashes; ++hash)
+		{
+			auto& value{ m_signature[static_cast<size_t>(hash)] };
+			value = std::min(value, minHash(subFingerprint, hash));
+		}
+		++m_numSubFingerprints;
+	}
+
+	std::swap(m_energies, m_previousEnergies);
+	m_hasPrevious = true;
+}
+
+void FingerprintAnalyzer::finish(File& file)
+{
+	file.m_fingerprint = (m_numSubFingerprints >= s_minSubFingerprints) ? std::move(m_signature) : Signature{};
+}
+
+//==============================================================================
+FingerprintIndex::FingerprintIndex(juce::File indexFile, juce::int64 startSampleOffset,
+                                   juce::int64 numSamplesToSearch) :
+		m_file{ std::move(indexFile) },
+		m_startSampleOffset{ startSampleOffset },
+		m_numSamplesToSearch{ numSamplesToSearch }
+{
+}
+
+bool FingerprintIndex::load()
+{
+	m_entries.clear();
+	m_lookup.clear();
+
+	// Signatures from another --offset/--num window aren't comparable, so the whole index is rebuilt
+	juce::FileInputStream stream{ m_file };
+	if (stream.failedToOpen() || static_cast<juce::uint32>(stream.readInt()) != s_indexMagic ||
+	    stream.readInt() != s_indexVersion || stream.readInt64() != m_startSampleOffset ||
+	    stream.readInt64() != m_numSamplesToSearch)
+	{
+		return false;
+	}
+
+	// A corrupt or truncated index is discarded as a whole rather than trusted partially
+	const auto discard = [this]
+	{
+		m_entries.clear();
+		m_lookup.clear();
+		return false;
+	};
+
+	const auto numEntries{ stream.readInt64() };
+	for (juce::int64 index{ 0 }; index < numEntries; ++index)
+	{
+		if (stream.isExhausted())
+		{
+			return discard();
+		}
+
+		Entry entry{};
+		entry.m_path = stream.readString();
+		entry.m_size = stream.readInt64();
+		entry.m_modified = stream.readInt64();
+
+		const auto numHashes{ stream.readInt() };
+		if (!juce::File::isAbsolutePath(entry.m_path) ||
+		    (numHashes != 0 && numHashes != FingerprintAnalyzer::s_numHashes) ||
+		    stream.getNumBytesRemaining() < static_cast<juce::int64>(numHashes) * 4)
+		{
+			return discard();
+		}
+
+		entry.m_signature.resize(static_cast<size_t>(numHashes));
+		for (auto& value : entry.m_signature)
+		{
+			value = static_cast<juce::uint32>(stream.readInt());
+		}
+
+		m_lookup[entry.m_path] = m_entries.size();
+		m_entries.push_back(std::move(entry));
+	}
+	return true;
+}
+
+bool FingerprintIndex::save() const
+{
+	juce::TemporaryFile temp{ m_file };
+	{
+		juce::FileOutputStream stream{ temp.getFile() };
+		if (stream.failedToOpen())
+		{
+			return false;
+		}
+
+		stream.writeInt(static_cast<int>(s_indexMagic));
+		stream.writeInt(s_indexVersion);
+		stream.writeInt64(m_startSampleOffset);
+		stream.writeInt64(m_numSamplesToSearch);
+		stream.writeInt64(static_cast<juce::int64>(m_entries.size()));
+		for (const auto& entry : m_entries)
+		{
+			stream.writeString(entry.m_path);
+			stream.writeInt64(entry.m_size);
+			stream.writeInt64(entry.m_modified);
+			stream.writeInt(static_cast<int>(entry.m_signature.size()));
+			for (const auto value : entry.m_signature)
+			{
+				stream.writeInt(static_cast<int>(value));
+			}
+		}
+		stream.flush();
+	}
+	return temp.overwriteTargetFileWithTemporary();
+}
+
+const Signature* FingerprintIndex::find(const juce::File& file) const
+{
+	const auto it{ m_lookup.find(file.getFullPathName()) };
+	if (it == m_lookup.end())
+	{
+		return nullptr;
+	}
+
+	const auto& entry{ m_entries[it->second] };
+	if (entry.m_size != file.getSize() || entry.m_modified != file.getLastModificationTime().toMilliseconds())
+	{
+		return nullptr;
+	}
+	return &entry.m_signature;
+}
+
+void FingerprintIndex::update(const juce::File& file, const Signature& signature)
+{
+	const Entry entry{ file.getFullPathName(), file.getSize(), file.getLastModificationTime().toMilliseconds(),
+	                   signature };
+	if (const auto it{ m_lookup.find(entry.m_path) }; it != m_lookup.end())
+	{
+		m_entries[it->second] = entry;
+		return;
+	}
+
+	m_lookup[entry.m_path] = m_entries.size();
+	m_entries.push_back(entry);
+}
+
+void FingerprintIndex::prune()
+{
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const Entry& entry)
+	{
+		return !juce::File(entry.m_path).existsAsFile();
+	}), m_entries.end());
+
+	m_lookup.clear();
+	for (size_t index{ 0 }; index < m_entries.size(); ++index)
+	{
+		m_lookup[m_entries[index].m_path] = index;
+	}
+}
+
+std::map<juce::String, Duplicate> FingerprintIndex::findDuplicates(float minSimilarity) const
+{
+	Profiler::ScopedStage stage{ Profiler::Stage::COMPUTE };
+
+	// Files sharing any band of their signature become candidate pairs
+	std::unordered_set<juce::uint64> candidates{};
+	for (auto band{ 0 }; band < s_numBandsLsh; ++band)
+	{
+		std::unordered_map<juce::uint64, std::vector<juce::uint32>> buckets{};
+		for (size_t index{ 0 }; index < m_entries.size(); ++index)
+		{
+			if (m_entries[index].m_signature.size() == static_cast<size_t>(FingerprintAnalyzer::s_numHashes))
+			{
+				buckets[bandKey(m_entries[index].m_signature, band)].push_back(static_cast<juce::uint32>(index));
+			}
+		}
+
+		for (const auto& [key, bucket] : buckets)
+		{
+			// Very crowded buckets are degenerate signatures (e.g. tones); skip rather than go quadratic
+			if (bucket.size() < 2 || bucket.size() > s_maxBucketSize)
+			{
+				continue;
+			}
+			for (size_t a{ 0 }; a < bucket.size(); ++a)
+			{
+				for (auto b{ a + 1 }; b < bucket.size(); ++b)
+				{
+					candidates.insert((static_cast<juce::uint64>(bucket[a]) << 32) | bucket[b]);
+				}
+			}
+		}
+	}
+
+	// Verify candidates on the full signature, clustering accepted pairs
+	std::vector<Duplicate> duplicates(m_entries.size());
+	std::vector<size_t> parents(m_entries.size());
+	std::iota(parents.begin(), parents.end(), static_cast<size_t>(0));
+	for (const auto pair : candidates)
+	{
+		const auto a{ static_cast<size_t>(pair >> 32) };
+		const auto b{ static_cast<size_t>(pair & 0xffffffffu) };
+		const auto score{ similarity(m_entries[a].m_signature, m_entries[b].m_signature) };
+		if (score < minSimilarity)
+		{
+			continue;
+		}
+
+		for (const auto& [self, other] : { std::pair{ a, b }, std::pair{ b, a } })
+		{
+			auto& duplicate{ duplicates[self] };
+			++duplicate.m_numDuplicates;
+			if (score > duplicate.m_similarity)
+			{
+				duplicate.m_similarity = score;
+				duplicate.m_closestMatch = m_entries[other].m_path;
+			}
+		}
+		parents[findRoot(parents, a)] = findRoot(parents, b);
+	}
+
+	// Keep the alphabetically first path of each cluster as the original
+	std::unordered_map<size_t, size_t> originals{};
+	for (size_t index{ 0 }; index < m_entries.size(); ++index)
+	{
+		const auto root{ findRoot(parents, index) };
+		const auto it{ originals.find(root) };
+		if (it == originals.end() || m_entries[index].m_path < m_entries[it->second].m_path)
+		{
+			originals[root] = index;
+		}
+	}
+
+	std::map<juce::String, Duplicate> result{};
+	for (size_t index{ 0 }; index < m_entries.size(); ++index)
+	{
+		if (duplicates[index].m_numDuplicates > 0)
+		{
+			duplicates[index].m_original = m_entries[originals[findRoot(parents, index)]].m_path;
+			result[m_entries[index].m_path] = duplicates[index];
+		}
+	}
+	return result;
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    fingerprint.h
+    Created: 19 Oct 2026 3:40:12pm
+    Author:  Aaron Cendan
+    Description: Spectral fingerprints and an on-disk LSH index for near-duplicate detection
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "analysis.h"
+
+#include <JuceHeader.h>
+#include <map>
+
+namespace zero
+{
+	// MinHash signature over the set of 32-bit sub-fingerprints in a file, empty if the file is silent or too short
+	using Signature = std::vector<juce::uint32>;
+
+	// Haitsma-Kalker style sub-fingerprints: signs of band energy differences across frequency and time, which
+	// survive gain changes, trims and re-encodes. Folded into a MinHash signature as the file streams past.
+	class FingerprintAnalyzer : public Analyzer
+	{
+	public:
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+		static constexpr auto s_numHashes{ 64 };
+
+	private:
+		void processFrame();
+
+		std::unique_ptr<juce::dsp::FFT> m_fft{ nullptr };
+		int m_frameSize{ 0 };
+		int m_hopSize{ 0 };
+		juce::Range<juce::int64> m_window{};
+
+		std::vector<float> m_fifo{};
+		int m_fifoFill{ 0 };
+		std::vector<float> m_windowTable{};
+		std::vector<float> m_fftData{};
+		std::vector<int> m_bandEdges{};
+		std::vector<float> m_energies{};
+		std::vector<float> m_previousEnergies{};
+		bool m_hasPrevious{ false };
+
+		Signature m_signature{};
+		int m_numSubFingerprints{ 0 };
+	};
+
+	struct Duplicate
+	{
+		juce::String m_closestMatch{};
+		float m_similarity{ -1.0f };
+		int m_numDuplicates{ 0 };
+		juce::String m_original{};  // First path in the cluster of near-duplicates, the one to keep
+	};
+
+	// Signatures keyed by path, reused across runs while size, modification time and the search window are unchanged.
+	// Candidates come from LSH banding of the signatures, so finding duplicates is linear in the library size.
+	class FingerprintIndex
+	{
+	public:
+		FingerprintIndex(juce::File indexFile, juce::int64 startSampleOffset, juce::int64 numSamplesToSearch);
+
+		bool load();
+		bool save() const;
+
+		const Signature* find(const juce::File& file) const;
+		void update(const juce::File& file, const Signature& signature);
+		void prune();
+
+		std::map<juce::String, Duplicate> findDuplicates(float minSimilarity) const;
+
+		size_t size() const { return m_entries.size(); }
+
+	private:
+		struct Entry
+		{
+			juce::String m_path{};
+			juce::int64 m_size{ 0 };
+			juce::int64 m_modified{ 0 };
+			Signature m_signature{};
+		};
+
+		juce::File m_file{};
+		juce::int64 m_startSampleOffset{ 0 };
+		juce::int64 m_numSamplesToSearch{ -1 };
+		std::vector<Entry> m_entries{};
+		std::map<juce::String, size_t> m_lookup{};
+	};
+}
@@ -0,0 +1,384 @@
+/*
+  ==============================================================================
+
+    flacindex.cpp
+    Created: 19 Oct 2026 6:21:22pm
+    Author:  Aaron Cendan
+    Description: FLAC frame-boundary index, so reverse searches seek straight to the last frames
+
+  ==============================================================================
+*/
+
+#include "flacindex.h"
+#include "profiler.h"
+
+#include <set>
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_streamInfoType{ 0 };
+	constexpr auto s_seekTableType{ 3 };
+	constexpr auto s_seekPointSize{ 18 };
+	constexpr auto s_maxFrameHeaderSize{ 16 };
+	constexpr juce::uint64 s_placeholderPoint{ 0xffffffffffffffffull };
+	constexpr juce::int64 s_tailMarginBytes{ 65536 };
+	constexpr auto s_defaultTailSeconds{ 30 };
+
+	juce::uint8 crc8(const juce::uint8* data, size_t size)
+	{
+		juce::uint8 crc{ 0 };
+		for (size_t index{ 0 }; index < size; ++index)
+		{
+			crc ^= data[index];
+			for (auto bit{ 0 }; bit < 8; ++bit)
+			{
+				crc = static_cast<juce::uint8>((crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1));
+			}
+		}
+		return crc;
+	}
+
+	void writeBigEndian(juce::MemoryBlock& block, juce::uint64 value, int numBytes)
+	{
+		for (auto byte{ numBytes - 1 }; byte >= 0; --byte)
+		{
+			const auto b{ static_cast<juce::uint8>((value >> (byte * 8)) & 0xff) };
+			block.append(&b, 1);
+		}
+	}
+
+	// Prepends a rebuilt metadata header, carrying the synthetic SEEKTABLE, to the untouched audio frames
+	class IndexedFlacStream : public juce::InputStream
+	{
+	public:
+		IndexedFlacStream(std::unique_ptr<juce::InputStream> source, juce::MemoryBlock header,
+		                  juce::int64 firstFrameOffset) :
+				m_stream{ std::move(source) }, m_header{ std::move(header) }, m_firstFrameOffset{ firstFrameOffset } { }
+
+		juce::int64 getTotalLength() override
+		{
+			return static_cast<juce::int64>(m_header.getSize()) + m_stream->getTotalLength() - m_firstFrameOffset;
+		}
+
+		bool isExhausted() override { return m_position >= getTotalLength(); }
+		juce::int64 getPosition() override { return m_position; }
+
+		bool setPosition(juce::int64 position) override
+		{
+			m_position = juce::jlimit(static_cast<juce::int64>(0), getTotalLength(), position);
+			return true;
+		}
+
+		int read(void* destination, int numBytes) override
+		{
+			auto* output{ static_cast<char*>(destination) };
+			const auto headerSize{ static_cast<juce::int64>(m_header.getSize()) };
+			auto numRead{ 0 };
+
+			if (m_position < headerSize)
+			{
+				const auto numThisTime{ static_cast<int>(juce::jmin(static_cast<juce::int64>(numBytes),
+				                                                    headerSize - m_position)) };
+				std::memcpy(output, static_cast<const char*>(m_header.getData()) + m_position,
+				            static_cast<size_t>(numThisTime));
+				m_position += numThisTime;
+				numRead += numThisTime;
+			}
+
+			if (numRead < numBytes && m_position >= headerSize)
+			{
+				m_stream->setPosition(m_firstFrameOffset + m_position - headerSize);
+				const auto numThisTime{ m_stream->read(output + numRead, numBytes - numRead) };
+				if (numThisTime > 0)
+				{
+					m_position += numThisTime;
+					numRead += numThisTime;
+				}
+			}
+			return numRead;
+		}
+
+	private:
+		std::unique_ptr<juce::InputStream> m_stream{};
+		juce::MemoryBlock m_header{};
+		juce::int64 m_firstFrameOffset{ 0 };
+		juce::int64 m_position{ 0 };
+	};
+}
+
+bool FlacFrameIndex::build(const juce::File& file, juce::int64 numTailSamples)
+{
+	Profiler::ScopedStage stage{ Profiler::Stage::READER };
+
+	m_file = file;
+	m_metadata.clear();
+	m_seekPoints.clear();
+	m_hasSeekTable = false;
+
+	juce::FileInputStream stream{ file };
+	if (stream.failedToOpen() || !readMetadata(stream))
+	{
+		return false;
+	}
+
+	if (!m_hasSeekTable)
+	{
+		scanTail(stream, numTailSamples);
+	}
+	return !m_seekPoints.empty();
+}
+
+bool FlacFrameIndex::readMetadata(juce::FileInputStream& stream)
+{
+	char marker[4]{};
+	if (stream.read(marker, 4) != 4 || std::memcmp(marker, "fLaC", 4) != 0)
+	{
+		return false;
+	}
+
+	auto isLast{ false };
+	while (!isLast && !stream.isExhausted())
+	{
+		juce::uint8 header[4]{};
+		if (stream.read(header, 4) != 4)
+		{
+			return false;
+		}
+
+		isLast = (header[0] & 0x80) != 0;
+		Metadata block{ header[0] & 0x7f, {} };
+		const auto length{ static_cast<size_t>(juce::ByteOrder::bigEndian24Bit(header + 1)) };
+		block.m_data.setSize(length);
+		if (stream.read(block.m_data.getData(), static_cast<int>(length)) != static_cast<int>(length))
+		{
+			return false;
+		}
+
+		const auto* data{ static_cast<const juce::uint8*>(block.m_data.getData()) };
+		if (block.m_type == s_streamInfoType && length >= 18)
+		{
+			m_minBlockSize = juce::ByteOrder::bigEndianShort(data);
+			m_maxBlockSize = juce::ByteOrder::bigEndianShort(data + 2);
+			m_sampleRate = (data[10] << 12) | (data[11] << 4) | (data[12] >> 4);
+			m_totalSamples = (static_cast<juce::int64>(data[13] & 0x0f) << 32) |
+			                 static_cast<juce::int64>(juce::ByteOrder::bigEndianInt(data + 14));
+		}
+		else if (block.m_type == s_seekTableType)
+		{
+			for (size_t point{ 0 }; point + s_seekPointSize <= length; point += s_seekPointSize)
+			{
+				const SeekPoint seekPoint{ juce::ByteOrder::bigEndianInt64(data + point),
+				                           juce::ByteOrder::bigEndianInt64(data + point + 8),
+				                           juce::ByteOrder::bigEndianShort(data + point + 16) };
+				if (seekPoint.m_sampleNumber != s_placeholderPoint)
+				{
+					m_seekPoints.push_back(seekPoint);
+				}
+			}
+			m_hasSeekTable = !m_seekPoints.empty();
+		}
+		m_metadata.push_back(std::move(block));
+	}
+
+	m_firstFrameOffset = stream.getPosition();
+	return m_minBlockSize > 0;
+}
+
+void FlacFrameIndex::scanTail(juce::FileInputStream& stream, juce::int64 numTailSamples)
+{
+	if (numTailSamples < 0)
+	{
+		numTailSamples = static_cast<juce::int64>(s_defaultTailSeconds) * m_sampleRate;
+	}
+
+	// Estimate how many bytes hold the requested tail from the average compressed size of a sample
+	const auto audioBytes{ stream.getTotalLength() - m_firstFrameOffset };
+	const auto bytesPerSample{ (m_totalSamples > 0) ? static_cast<double>(audioBytes) /
+	                                                  static_cast<double>(m_totalSamples) : 1.0 };
+	const auto tailBytes{ static_cast<juce::int64>(static_cast<double>(numTailSamples) * bytesPerSample * 1.25) +
+	                      s_tailMarginBytes };
+	const auto scanStart{ std::max(m_firstFrameOffset, stream.getTotalLength() - tailBytes) };
+
+	juce::MemoryBlock tail{};
+	stream.setPosition(scanStart);
+	stream.readIntoMemoryBlock(tail, static_cast<ssize_t>(stream.getTotalLength() - scanStart));
+	const auto* data{ static_cast<const juce::uint8*>(tail.getData()) };
+	const auto size{ tail.getSize() };
+
+	// Candidate headers: sync code plus a valid CRC-8
+	std::vector<SeekPoint> candidates{};
+	for (size_t index{ 0 }; index + 1 < size; ++index)
+	{
+		if (data[index] != 0xff || (data[index + 1] & 0xfe) != 0xf8)
+		{
+			continue;
+		}
+
+		SeekPoint point{};
+		if (parseFrameHeader(data + index, size - index, point))
+		{
+			point.m_byteOffset = static_cast<juce::uint64>(scanStart + static_cast<juce::int64>(index) -
+			                                               m_firstFrameOffset);
+			candidates.push_back(point);
+		}
+	}
+
+	// A CRC-8 match can be coincidental, so only keep frames that chain onto a neighbour or the end of the stream
+	std::set<juce::uint64> starts{};
+	std::set<juce::uint64> ends{};
+	for (const auto& point : candidates)
+	{
+		starts.insert(point.m_sampleNumber);
+		ends.insert(point.m_sampleNumber + point.m_numFrameSamples);
+	}
+
+	std::set<juce::uint64> seen{};
+	for (const auto& point : candidates)
+	{
+		const auto end{ point.m_sampleNumber + point.m_numFrameSamples };
+		const auto chains{ starts.count(end) > 0 || ends.count(point.m_sampleNumber) > 0 ||
+		                   end == static_cast<juce::uint64>(m_totalSamples) };
+		if (chains && seen.insert(point.m_sampleNumber).second)
+		{
+			m_seekPoints.push_back(point);
+		}
+	}
+
+	// The first frame is always at offset zero; its header anchors seeks before the indexed tail
+	juce::uint8 firstHeader[s_maxFrameHeaderSize]{};
+	stream.setPosition(m_firstFrameOffset);
+	SeekPoint first{};
+	if (stream.read(firstHeader, s_maxFrameHeaderSize) == s_maxFrameHeaderSize &&
+	    parseFrameHeader(firstHeader, s_maxFrameHeaderSize, first) && seen.count(0) == 0)
+	{
+		m_seekPoints.insert(m_seekPoints.begin(), first);
+	}
+
+	std::sort(m_seekPoints.begin(), m_seekPoints.end(), [](const SeekPoint& a, const SeekPoint& b)
+	{
+		return a.m_sampleNumber < b.m_sampleNumber;
+	});
+}
+
+bool FlacFrameIndex::parseFrameHeader(const juce::uint8* data, size_t size, SeekPoint& point) const
+{
+	if (size < 6)
+	{
+		return false;
+	}
+
+	const auto isVariableBlockSize{ (data[1] & 0x01) != 0 };
+	const auto blockSizeCode{ data[2] >> 4 };
+	const auto sampleRateCode{ data[2] & 0x0f };
+	const auto channelCode{ data[3] >> 4 };
+	const auto sampleSizeCode{ (data[3] >> 1) & 0x07 };
+	if (blockSizeCode == 0 || sampleRateCode == 0x0f || channelCode > 10 || sampleSizeCode == 3 ||
+	    (data[3] & 0x01) != 0)
+	{
+		return false;
+	}
+
+	// UTF-8 style coded frame or sample number
+	size_t position{ 4 };
+	juce::uint64 number{ data[position] };
+	auto numExtraBytes{ 0 };
+	if ((number & 0x80) != 0)
+	{
+		while (numExtraBytes < 7 && (number & (0x40u >> numExtraBytes)) != 0)
+		{
+			++numExtraBytes;
+		}
+		if (numExtraBytes == 0 || numExtraBytes > 6)
+		{
+			return false;
+		}
+		number &= (0x3fu >> numExtraBytes);
+	}
+	++position;
+
+	for (auto byte{ 0 }; byte < numExtraBytes; ++byte, ++position)
+	{
+		if (position >= size || (data[position] & 0xc0) != 0x80)
+		{
+			return false;
+		}
+		number = (number << 6) | (data[position] & 0x3f);
+	}
+
+	auto numFrameSamples{ 0 };
+	if (blockSizeCode == 1)
+	{
+		numFrameSamples = 192;
+	}
+	else if (blockSizeCode <= 5)
+	{
+		numFrameSamples = 576 << (blockSizeCode - 2);
+	}
+	else if (blockSizeCode == 6)
+	{
+		numFrameSamples = (position < size) ? data[position] + 1 : 0;
+		position += 1;
+	}
+	else if (blockSizeCode == 7)
+	{
+		numFrameSamples = (position + 1 < size) ? juce::ByteOrder::bigEndianShort(data + position) + 1 : 0;
+		position += 2;
+	}
+	else
+	{
+		numFrameSamples = 256 << (blockSizeCode - 8);
+	}
+
+	if (sampleRateCode == 12)
+	{
+		position += 1;
+	}
+	else if (sampleRateCode == 13 || sampleRateCode == 14)
+	{
+		position += 2;
+	}
+
+	if (position >= size || numFrameSamples <= 0 || numFrameSamples > std::max(m_maxBlockSize, 16) ||
+	    crc8(data, position) != data[position])
+	{
+		return false;
+	}
+
+	point.m_sampleNumber = isVariableBlockSize ? number : number * static_cast<juce::uint64>(m_minBlockSize);
+	point.m_numFrameSamples = static_cast<juce::uint16>(numFrameSamples);
+	return m_totalSamples <= 0 || point.m_sampleNumber < static_cast<juce::uint64>(m_totalSamples);
+}
+
+std::unique_ptr<juce::InputStream> FlacFrameIndex::createIndexedStream(std::unique_ptr<juce::InputStream> source) const
+{
+	if (m_hasSeekTable || m_seekPoints.empty())
+	{
+		return nullptr;
+	}
+	if (source == nullptr)
+	{
+		source = std::make_unique<juce::FileInputStream>(m_file);
+	}
+
+	// Original metadata blocks, none flagged as last, followed by the SEEKTABLE
+	juce::MemoryBlock header{ "fLaC", 4 };
+	for (const auto& block : m_metadata)
+	{
+		writeBigEndian(header, static_cast<juce::uint64>(block.m_type), 1);
+		writeBigEndian(header, block.m_data.getSize(), 3);
+		header.append(block.m_data.getData(), block.m_data.getSize());
+	}
+
+	writeBigEndian(header, 0x80 | s_seekTableType, 1);
+	writeBigEndian(header, m_seekPoints.size() * s_seekPointSize, 3);
+	for (const auto& point : m_seekPoints)
+	{
+		writeBigEndian(header, point.m_sampleNumber, 8);
+		writeBigEndian(header, point.m_byteOffset, 8);
+		writeBigEndian(header, point.m_numFrameSamples, 2);
+	}
+
+	return std::make_unique<IndexedFlacStream>(std::move(source), std::move(header), m_firstFrameOffset);
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    flacindex.h
+    Created: 19 Oct 2026 6:21:14pm
+    Author:  Aaron Cendan
+    Description: FLAC frame-boundary index, so reverse searches seek straight to the last frames
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+namespace zero
+{
+	// Frame boundaries of a FLAC stream, loaded from its SEEKTABLE or found by scanning frame headers in the tail
+	// of the file without decoding. Files lacking a SEEKTABLE get one injected at read time, so the decoder seeks
+	// directly to indexed frames instead of bisecting the whole file.
+	class FlacFrameIndex
+	{
+	public:
+		struct SeekPoint
+		{
+			juce::uint64 m_sampleNumber{ 0 };
+			juce::uint64 m_byteOffset{ 0 };  // From the first frame header
+			juce::uint16 m_numFrameSamples{ 0 };
+		};
+
+		// Indexes frames covering at least the last numTailSamples samples (-1 for a default of 30 seconds)
+		bool build(const juce::File& file, juce::int64 numTailSamples);
+
+		bool hasSeekTable() const { return m_hasSeekTable; }
+		const std::vector<SeekPoint>& getSeekPoints() const { return m_seekPoints; }
+
+		// Stream with a synthetic SEEKTABLE for the decoder, or nullptr if the file already has one. Audio frames come
+		// from source when given (e.g. a prefetched stream of the same file), otherwise from the file itself. Building
+		// the index scans the tail, so build it once per file and create a stream for each reader.
+		std::unique_ptr<juce::InputStream> createIndexedStream(std::unique_ptr<juce::InputStream> source = nullptr) const;
+
+	private:
+		struct Metadata
+		{
+			int m_type{ 0 };
+			juce::MemoryBlock m_data{};
+		};
+
+		bool readMetadata(juce::FileInputStream& stream);
+		void scanTail(juce::FileInputStream& stream, juce::int64 numTailSamples);
+		bool parseFrameHeader(const juce::uint8* data, size_t size, SeekPoint& point) const;
+
+		juce::File m_file{};
+		std::vector<Metadata> m_metadata{};
+		juce::int64 m_firstFrameOffset{ 0 };
+		int m_minBlockSize{ 0 };
+		int m_maxBlockSize{ 0 };
+		int m_sampleRate{ 0 };
+		juce::int64 m_totalSamples{ 0 };
+		bool m_hasSeekTable{ false };
+		std::vector<SeekPoint> m_seekPoints{};
+	};
+}
@@ -42,15 +42,60 @@ USAGE:
     # Run zerochecker, default analysis mode. No optional parameters required. Scan two different files.
     .\zerochecker.exe 'C:\folder\cool_file.wav' 'C:\folder\weird_file.flac'
 
+    # Run zerochecker on multi-hour field recordings past 4 GB (.rf64/.w64), or on .aif(f) files. Trim and mono
+    # conversion stream in blocks, so memory use stays flat regardless of file length.
+    .\zerochecker.exe 'C:\folder\dawn_chorus.w64' 'C:\folder\city_ambience.rf64' 'C:\folder\foley.aiff'
+
     # Run monochecker, mono compatibility mode [-m]. Scans all audio files in subfolder (recursively).
     .\zerochecker.exe -m 'C:\folder\subfolder\'
 
+    # Run zerochecker, monochecker and level metrics together, decoding each file only once.
+    .\zerochecker.exe --analyze=zero,mono,level 'C:\folder\subfolder\'
+
+    # Run loop click-risk analysis [-l], comparing 2048 samples on either side of the loop seam.
+    .\zerochecker.exe -l 2048 'C:\folder\loops\'
+
+    # Run gap segmentation [-g], listing sound regions separated by at least 250 ms of silence.
+    .\zerochecker.exe -g 250 --min=0.01 'C:\folder\sessions\'
+
+    # Run alignment analysis [--align], comparing per-language VO takes named like 'vo_001_en.wav', 'vo_001_fr.wav'.
+    .\zerochecker.exe --align='_(en|fr|de)$' 'C:\folder\vo\'
+
+    # Sweep thresholds [--sweep], listing first and last non-zeroes for 3 minimums x 3 consec counts in one pass.
+    .\zerochecker.exe --sweep=0.001,0.003,0.01 --sweep-consec=0,16,64 -c 'C:\folder\sweep.csv' 'C:\folder\sfx\'
+
+    # Measure EBU R128 loudness [--loudness], comparing integrated loudness against -16 LUFS and flagging true peaks.
+    .\zerochecker.exe --loudness=-16 -c 'C:\folder\loudness.csv' 'C:\folder\masters\'
+
+    # Find near-duplicates [--dupes], keeping fingerprints in an index so unchanged files are skipped next time.
+    .\zerochecker.exe --dupes='C:\folder\library.zfp' 'C:\folder\library\'
+
+    # Watch export folders [--watch], analyzing files once untouched for 3 seconds and appending rows to a .csv.
+    .\zerochecker.exe --watch=3000 -c 'C:\folder\watch_log.csv' 'C:\exports\sfx\' 'C:\exports\vo\'
+
+    # Keep a server running [--serve], then send small batches to it from build tools [--client] as JSON.
+    ./zerochecker --serve=/tmp/zerochecker.sock
+    ./zerochecker --client=/tmp/zerochecker.sock --analyze=zero,level --min=0.01 ./exports/ui_click.wav
+
+    # Split an archive audit across 4 machines [--shard], then combine their outputs into one report [--merge].
+    .\zerochecker.exe --shard=2/4 -c 'C:\audit\shard2.ndjson' 'C:\archive\'
+    .\zerochecker.exe --merge -c 'C:\audit\archive.csv' 'C:\audit\shard1.ndjson' 'C:\audit\shard2.ndjson' ...
+
+    # Run monochecker on a CI agent, holding at most 2 GB of buffers at once for files over 64 MB [--max-memory].
+    .\zerochecker.exe -m --max-memory=2048 'C:\folder\stems\'
+
     # Run zerochecker, outputting results to a .csv file.
     .\zerochecker.exe -c 'C:\folder\output_log.csv' 'C:\folder\subfolder\'
 
     # Run zerochecker, various optional parameters set.
     .\zerochecker.exe --min=0.1 --consec=5 'C:\folder\weird_file.flac'
 
+    # Run zerochecker with cached peak pyramids [--pyramid]. Later runs with other thresholds barely decode audio.
+    .\zerochecker.exe --pyramid='C:\cache\pyramids' --min=0.01 'C:\folder\subfolder\'
+
+    # Run zerochecker, printing per-stage timings and the 5 slowest files.
+    .\zerochecker.exe --profile=5 'C:\folder\subfolder\'
+
 NOTE:
     Short options like '-x' should have a space, followed by the desired value.
     Long options like '--max' should have an equals sign instead. Refer to USAGE above.
@@ -61,6 +106,11 @@ OPTIONS:)" };
 	constexpr auto endl{ "\n" };
 	constexpr auto divider{ "=========================================================================" };
 	constexpr auto nil{ "N/A" };
+	constexpr auto silent{ "Silent" };
 
 	constexpr auto fullPathHeader{ "Full Path" };
+
+	// Shared by local scans and --client, so both pick up the same files
+	constexpr auto audioFileWildcard{ "*.wav;*.flac;*.aif;*.aiff;*.w64;*.rf64" };
+	constexpr auto audioFileExtensions{ "wav;flac;aif;aiff;w64;rf64" };
 }
\ No newline at end of file
@@ -0,0 +1,335 @@
+/*
+  ==============================================================================
+
+    loudness.cpp
+    Created: 20 Oct 2026 1:06:38am
+    Author:  Aaron Cendan
+    Description: Streaming EBU R128 integrated loudness, loudness range and true peak
+
+  ==============================================================================
+*/
+
+#include "loudness.h"
+#include "file.h"
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_absoluteGate{ -70.0 };           // LUFS
+	constexpr auto s_integratedRelativeGate{ -10.0 }; // LU below the mean of blocks past the absolute gate
+	constexpr auto s_rangeRelativeGate{ -20.0 };
+	constexpr auto s_rangeLowPercentile{ 0.10 };
+	constexpr auto s_rangeHighPercentile{ 0.95 };
+	constexpr auto s_momentarySubBlocks{ 4 };
+
+	// Blocks louder than the top bin are still counted there, with their exact energy
+	constexpr auto s_maxHistogramLoudness{ 5.0 };
+	constexpr auto s_binsPerLu{ 20 };
+	constexpr auto s_numBins{ static_cast<int>((s_maxHistogramLoudness - s_absoluteGate) * s_binsPerLu) };
+
+	// K-weighting as analog prototypes, giving the BS.1770-4 coefficients at 48 kHz and matching curves at other rates
+	constexpr auto s_shelfFrequency{ 1681.974450955533 };
+	constexpr auto s_shelfGain{ 3.999843853973347 };
+	constexpr auto s_shelfQ{ 0.7071752369554196 };
+	constexpr auto s_highPassFrequency{ 38.13547087602444 };
+	constexpr auto s_highPassQ{ 0.5003270373238773 };
+	constexpr auto s_surroundWeight{ 1.41 };
+
+	// BS.1770-4 Annex 2 interpolation filter, one row per phase of 4x oversampling
+	constexpr std::array<std::array<float, LoudnessAnalyzer::s_numTruePeakTaps>, LoudnessAnalyzer::s_numTruePeakPhases>
+			s_truePeakPhases{ {
+			{ 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f,
+			  0.1373291015625f, 0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f,
+			  0.0148925781250f, -0.0083007812500f },
+			{ -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f,
+			  0.4650878906250f, 0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f,
+			  0.0330810546875f, -0.0189208984375f },
+			{ -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f,
+			  0.7797851562500f, 0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f,
+			  0.0292968750000f, -0.0291748046875f },
+			{ -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f,
+			  0.9721679687500f, 0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f,
+			  0.0109863281250f, 0.0017089843750f } } };
+
+	// Interpolated points for consecutive input samples are computed side by side, so the sums stay in registers for
+	// every tap and the loops over outputs vectorise; much cheaper than one pass over the block per tap
+	constexpr auto s_numTruePeakOutputs{ 8 };
+
+	template <size_t numOutputs>
+	void accumulateInterpolatedPeaks(const float* newest, std::array<float, numOutputs>& peaks)
+	{
+		for (const auto& phase : s_truePeakPhases)
+		{
+			std::array<float, numOutputs> sums{};
+			for (auto tap{ 0 }; tap < LoudnessAnalyzer::s_numTruePeakTaps; ++tap)
+			{
+				const auto coefficient{ phase[static_cast<size_t>(tap)] };
+				for (size_t output{ 0 }; output < numOutputs; ++output)
+				{
+					sums[output] += coefficient * newest[static_cast<int>(output) - tap];
+				}
+			}
+			for (size_t output{ 0 }; output < numOutputs; ++output)
+			{
+				peaks[output] = std::max(peaks[output], std::abs(sums[output]));
+			}
+		}
+	}
+
+	double toLoudness(double energy)
+	{
+		return (energy > 0.0) ? -0.691 + 10.0 * std::log10(energy) : -std::numeric_limits<double>::infinity();
+	}
+
+	int toBin(double loudness)
+	{
+		return juce::jlimit(0, s_numBins - 1, static_cast<int>((loudness - s_absoluteGate) * s_binsPerLu));
+	}
+
+	double fromBin(int bin)
+	{
+		return s_absoluteGate + (static_cast<double>(bin) + 0.5) / s_binsPerLu;
+	}
+}
+
+void LoudnessAnalyzer::Histogram::add(double energy)
+{
+	const auto loudness{ toLoudness(energy) };
+	if (loudness < s_absoluteGate)
+	{
+		return;
+	}
+
+	const auto bin{ static_cast<size_t>(toBin(loudness)) };
+	++m_counts[bin];
+	m_energies[bin] += energy;
+}
+
+double LoudnessAnalyzer::Histogram::getMeanEnergy(double minLoudness) const
+{
+	juce::int64 numBlocks{ 0 };
+	auto energy{ 0.0 };
+	for (auto bin{ toBin(minLoudness) }; bin < s_numBins; ++bin)
+	{
+		numBlocks += m_counts[static_cast<size_t>(bin)];
+		energy += m_energies[static_cast<size_t>(bin)];
+	}
+	return (numBlocks > 0) ? energy / static_cast<double>(numBlocks) : 0.0;
+}
+
+double LoudnessAnalyzer::Histogram::getPercentile(double minLoudness, double fraction) const
+{
+	const auto numBlocks{ getNumBlocks(minLoudness) };
+	const auto rank{ static_cast<juce::int64>(static_cast<double>(numBlocks - 1) * fraction + 0.5) };
+	juce::int64 numBelow{ 0 };
+	for (auto bin{ toBin(minLoudness) }; bin < s_numBins; ++bin)
+	{
+		numBelow += m_counts[static_cast<size_t>(bin)];
+		if (numBelow > rank)
+		{
+			return fromBin(bin);
+		}
+	}
+	return fromBin(s_numBins - 1);
+}
+
+juce::int64 LoudnessAnalyzer::Histogram::getNumBlocks(double minLoudness) const
+{
+	juce::int64 numBlocks{ 0 };
+	for (auto bin{ toBin(minLoudness) }; bin < s_numBins; ++bin)
+	{
+		numBlocks += m_counts[static_cast<size_t>(bin)];
+	}
+	return numBlocks;
+}
+
+//==============================================================================
+void LoudnessAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows)
+{
+	m_window = windows.m_forward;
+	const auto sampleRate{ reader.sampleRate };
+
+	// Pre-filter: high shelf modelling the acoustic effect of the head
+	{
+		const auto k{ std::tan(juce::MathConstants<double>::pi * s_shelfFrequency / sampleRate) };
+		const auto vh{ std::pow(10.0, s_shelfGain / 20.0) };
+		const auto vb{ std::pow(vh, 0.4996667741545416) };
+		const auto a0{ 1.0 + k / s_shelfQ + k * k };
+		m_shelf = { (vh + vb * k / s_shelfQ + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / s_shelfQ + k * k) / a0,
+		            2.0 * (k * k - 1.0) / a0, (1.0 - k / s_shelfQ + k * k) / a0 };
+	}
+
+	// RLB weighting: second order high-pass
+	{
+		const auto k{ std::tan(juce::MathConstants<double>::pi * s_highPassFrequency / sampleRate) };
+		const auto a0{ 1.0 + k / s_highPassQ + k * k };
+		m_highPass = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / s_highPassQ + k * k) / a0 };
+	}
+
+	// WAV channel order; LFE isn't measured and surrounds count +1.5 dB
+	m_channels.assign(reader.numChannels, Channel{});
+	if (m_channels.size() == 5)
+	{
+		m_channels[3].m_weight = s_surroundWeight;
+		m_channels[4].m_weight = s_surroundWeight;
+	}
+	else if (m_channels.size() >= 6)
+	{
+		m_channels[3].m_weight = 0.0;
+		m_channels[4].m_weight = s_surroundWeight;
+		m_channels[5].m_weight = s_surroundWeight;
+	}
+
+	m_subBlockSize = std::max(juce::roundToInt(sampleRate / 10.0), 1);
+	m_subBlockFill = 0;
+	m_subBlockEnergy = 0.0;
+	m_numSubBlocks = 0;
+	for (auto* histogram : { &m_momentary, &m_shortTerm })
+	{
+		histogram->m_counts.assign(s_numBins, 0);
+		histogram->m_energies.assign(s_numBins, 0.0);
+	}
+	m_truePeak = 0.0f;
+}
+
+void LoudnessAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	// Only the forward window contributes, as the reverse window may overlap it out of order
+	const auto range{ m_window.getIntersectionWith({ blockStart, blockStart + numSamples }) };
+	if (range.isEmpty())
+	{
+		return;
+	}
+
+	// Filter state decays towards denormals through long silences
+	const juce::ScopedNoDenormals noDenormals{};
+
+	const auto offset{ static_cast<int>(range.getStart() - blockStart) };
+	const auto numInRange{ static_cast<int>(range.getLength()) };
+	const auto numChannels{ std::min(block.getNumChannels(), static_cast<int>(m_channels.size())) };
+	for (auto ch{ 0 }; ch < numChannels; ++ch)
+	{
+		measureTruePeak(m_channels[static_cast<size_t>(ch)], block.getReadPointer(ch) + offset, numInRange);
+	}
+
+	// K-weighted energy, split wherever a 100 ms step ends
+	for (auto done{ 0 }; done < numInRange;)
+	{
+		const auto numThisTime{ std::min(numInRange - done, m_subBlockSize - m_subBlockFill) };
+		for (auto ch{ 0 }; ch < numChannels; ++ch)
+		{
+			auto& channel{ m_channels[static_cast<size_t>(ch)] };
+			if (channel.m_weight > 0.0)
+			{
+				m_subBlockEnergy += channel.m_weight *
+				                    filter(channel, block.getReadPointer(ch) + offset + done, numThisTime);
+			}
+		}
+
+		done += numThisTime;
+		m_subBlockFill += numThisTime;
+		if (m_subBlockFill == m_subBlockSize)
+		{
+			pushSubBlock(m_subBlockEnergy / static_cast<double>(m_subBlockSize));
+			m_subBlockEnergy = 0.0;
+			m_subBlockFill = 0;
+		}
+	}
+}
+
+double LoudnessAnalyzer::filter(Channel& channel, const float* data, int numSamples) const
+{
+	// Both stages run in one loop over the whole block with their state in locals
+	auto [shelf1, shelf2, highPass1, highPass2]{ channel.m_state };
+	auto sumOfSquares{ 0.0 };
+	for (auto index{ 0 }; index < numSamples; ++index)
+	{
+		const auto smpl{ static_cast<double>(data[index]) };
+		const auto shelved{ m_shelf.m_b0 * smpl + shelf1 };
+		shelf1 = m_shelf.m_b1 * smpl - m_shelf.m_a1 * shelved + shelf2;
+		shelf2 = m_shelf.m_b2 * smpl - m_shelf.m_a2 * shelved;
+
+		const auto weighted{ m_highPass.m_b0 * shelved + highPass1 };
+		highPass1 = m_highPass.m_b1 * shelved - m_highPass.m_a1 * weighted + highPass2;
+		highPass2 = m_highPass.m_b2 * shelved - m_highPass.m_a2 * weighted;
+
+		sumOfSquares += weighted * weighted;
+	}
+	channel.m_state = { shelf1, shelf2, highPass1, highPass2 };
+	return sumOfSquares;
+}
+
+void LoudnessAnalyzer::measureTruePeak(Channel& channel, const float* data, int numSamples)
+{
+	const auto samplePeak{ juce::FloatVectorOperations::findMinAndMax(data, numSamples) };
+	m_truePeak = std::max({ m_truePeak, std::abs(samplePeak.getStart()), std::abs(samplePeak.getEnd()) });
+
+	// The end of the previous block goes in front, so the first interpolated points see the whole filter
+	constexpr auto numHistory{ s_numTruePeakTaps - 1 };
+	m_padded.resize(static_cast<size_t>(numHistory + numSamples));
+	std::copy(channel.m_history.begin(), channel.m_history.end(), m_padded.begin());
+	juce::FloatVectorOperations::copy(m_padded.data() + numHistory, data, numSamples);
+
+	std::array<float, s_numTruePeakOutputs> peaks{};
+	auto index{ 0 };
+	for (; index + s_numTruePeakOutputs <= numSamples; index += s_numTruePeakOutputs)
+	{
+		accumulateInterpolatedPeaks(m_padded.data() + numHistory + index, peaks);
+	}
+	for (; index < numSamples; ++index)
+	{
+		std::array<float, 1> peak{};
+		accumulateInterpolatedPeaks(m_padded.data() + numHistory + index, peak);
+		peaks[0] = std::max(peaks[0], peak[0]);
+	}
+	m_truePeak = std::max(m_truePeak, *std::max_element(peaks.begin(), peaks.end()));
+	std::copy(m_padded.end() - numHistory, m_padded.end(), channel.m_history.begin());
+}
+
+void LoudnessAnalyzer::pushSubBlock(double energy)
+{
+	m_subBlocks[static_cast<size_t>(m_numSubBlocks % s_shortTermSubBlocks)] = energy;
+	++m_numSubBlocks;
+
+	const auto meanOfLast = [this](int numSubBlocks)
+	{
+		auto sum{ 0.0 };
+		for (auto back{ 1 }; back <= numSubBlocks; ++back)
+		{
+			sum += m_subBlocks[static_cast<size_t>((m_numSubBlocks - back) % s_shortTermSubBlocks)];
+		}
+		return sum / numSubBlocks;
+	};
+
+	// 400 ms momentary and 3 s short-term blocks, both advancing in 100 ms steps
+	if (m_numSubBlocks >= s_momentarySubBlocks)
+	{
+		m_momentary.add(meanOfLast(s_momentarySubBlocks));
+	}
+	if (m_numSubBlocks >= s_shortTermSubBlocks)
+	{
+		m_shortTerm.add(meanOfLast(s_shortTermSubBlocks));
+	}
+}
+
+void LoudnessAnalyzer::finish(File& file)
+{
+	file.m_loudness = {};
+	file.m_loudness.m_truePeak = m_truePeak;
+
+	// Gated means are exact, apart from blocks sharing the bin the relative gate falls in
+	if (const auto ungated{ m_momentary.getMeanEnergy(s_absoluteGate) }; ungated > 0.0)
+	{
+		const auto gated{ m_momentary.getMeanEnergy(toLoudness(ungated) + s_integratedRelativeGate) };
+		file.m_loudness.m_integrated = static_cast<float>(toLoudness(gated));
+	}
+
+	// Spread between the quiet and loud ends of the short-term loudness distribution
+	if (const auto ungated{ m_shortTerm.getMeanEnergy(s_absoluteGate) }; ungated > 0.0)
+	{
+		const auto gate{ toLoudness(ungated) + s_rangeRelativeGate };
+		file.m_loudness.m_range = static_cast<float>(m_shortTerm.getPercentile(gate, s_rangeHighPercentile) -
+		                                             m_shortTerm.getPercentile(gate, s_rangeLowPercentile));
+	}
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    loudness.h
+    Created: 20 Oct 2026 1:06:31am
+    Author:  Aaron Cendan
+    Description: Streaming EBU R128 integrated loudness, loudness range and true peak
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "analysis.h"
+
+#include <JuceHeader.h>
+#include <array>
+
+namespace zero
+{
+	// EBU R128 loudness (ITU-R BS.1770-4, EBU Tech 3341/3342) in one pass over the forward window: K-weighted energy
+	// in 100 ms steps feeds the gated 400 ms and 3 s blocks, and true peak comes from 4x polyphase oversampling of each
+	// block. Gated blocks are counted in fixed-size loudness histograms rather than stored, so memory stays the same
+	// for a one-second effect and a ten-hour recording.
+	class LoudnessAnalyzer : public Analyzer
+	{
+	public:
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+		static constexpr auto s_numTruePeakPhases{ 4 };
+		static constexpr auto s_numTruePeakTaps{ 12 };
+		static constexpr auto s_shortTermSubBlocks{ 30 };
+
+	private:
+		struct Biquad
+		{
+			double m_b0{ 1.0 };
+			double m_b1{ 0.0 };
+			double m_b2{ 0.0 };
+			double m_a1{ 0.0 };
+			double m_a2{ 0.0 };
+		};
+
+		struct Channel
+		{
+			double m_weight{ 1.0 };
+			std::array<double, 4> m_state{}; // Transposed direct form II, two per filter stage
+			std::array<float, s_numTruePeakTaps - 1> m_history{};
+		};
+
+		// Gated blocks by loudness, with the energy of each bin so gated means don't depend on the bin width
+		struct Histogram
+		{
+			void add(double energy);
+			double getMeanEnergy(double minLoudness) const;
+			double getPercentile(double minLoudness, double fraction) const;
+			juce::int64 getNumBlocks(double minLoudness) const;
+
+			std::vector<juce::int64> m_counts{};
+			std::vector<double> m_energies{};
+		};
+
+		double filter(Channel& channel, const float* data, int numSamples) const;
+		void measureTruePeak(Channel& channel, const float* data, int numSamples);
+		void pushSubBlock(double energy);
+
+		juce::Range<juce::int64> m_window{};
+		Biquad m_shelf{};
+		Biquad m_highPass{};
+		std::vector<Channel> m_channels{};
+
+		int m_subBlockSize{ 0 };
+		int m_subBlockFill{ 0 };
+		double m_subBlockEnergy{ 0.0 };
+		std::array<double, s_shortTermSubBlocks> m_subBlocks{};
+		juce::int64 m_numSubBlocks{ 0 };
+		Histogram m_momentary{};
+		Histogram m_shortTerm{};
+
+		std::vector<float> m_padded{};
+		float m_truePeak{ 0.0f };
+	};
+}
@@ -9,11 +9,18 @@
 */
 
 #include "zerochecker.h"
+#include "server.h"
 
 int main(int argc, char* argv[])
 {
 	try
 	{
+		// Clients only forward a request, so skip registering formats and commands for a local scan
+		if (const juce::ArgumentList args{ argc, argv }; args.containsOption("--client"))
+		{
+			return juce::ConsoleApplication::invokeCatchingFailures([&] { return zero::Server::runClient(args); });
+		}
+
 		zero::Checker zerochecker;
 		return zerochecker.run({ argc, argv });
 	}
@@ -0,0 +1,419 @@
+/*
+  ==============================================================================
+
+    prefetch.cpp
+    Created: 19 Oct 2026 11:38:52pm
+    Author:  Aaron Cendan
+    Description: Batched head/tail reads through io_uring, so zero searches on many small files keep the device busy
+
+  ==============================================================================
+*/
+
+#include "prefetch.h"
+#include "profiler.h"
+
+#if defined (JUCE_LINUX)
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace zero;
+
+namespace
+{
+	// Serves reads inside prefetched regions from memory, and opens the file only for reads that fall outside them
+	class PrefetchedInputStream : public juce::InputStream
+	{
+	public:
+		PrefetchedInputStream(const juce::File& file, std::shared_ptr<const BlockPrefetcher::Regions> regions) :
+				m_file{ file }, m_regions{ std::move(regions) } { }
+
+		juce::int64 getTotalLength() override { return m_regions->m_fileSize; }
+		bool isExhausted() override { return m_position >= getTotalLength(); }
+		juce::int64 getPosition() override { return m_position; }
+
+		bool setPosition(juce::int64 position) override
+		{
+			m_position = juce::jlimit(static_cast<juce::int64>(0), getTotalLength(), position);
+			return true;
+		}
+
+		int read(void* destination, int numBytes) override
+		{
+			auto* output{ static_cast<char*>(destination) };
+			auto numRead{ 0 };
+			while (numRead < numBytes && !isExhausted())
+			{
+				const auto numWanted{ static_cast<juce::int64>(numBytes - numRead) };
+				const auto numThisTime{ copyFromRegions(output + numRead, numWanted) };
+				const auto numFromFile{ (numThisTime > 0) ? 0 : readFromFile(output + numRead, numWanted) };
+				if (numThisTime + numFromFile <= 0)
+				{
+					break;
+				}
+				m_position += numThisTime + numFromFile;
+				numRead += numThisTime + numFromFile;
+			}
+			return numRead;
+		}
+
+	private:
+		int copyFromRegions(char* output, juce::int64 numWanted) const
+		{
+			for (const auto& region : m_regions->m_regions)
+			{
+				const auto regionEnd{ region.m_offset + static_cast<juce::int64>(region.m_data.getSize()) };
+				if (m_position >= region.m_offset && m_position < regionEnd)
+				{
+					const auto numThisTime{ static_cast<int>(juce::jmin(numWanted, regionEnd - m_position)) };
+					std::memcpy(output, static_cast<const char*>(region.m_data.getData()) + (m_position - region.m_offset),
+					            static_cast<size_t>(numThisTime));
+					return numThisTime;
+				}
+			}
+			return 0;
+		}
+
+		// Stops at the next region, so whatever follows is served from memory again
+		int readFromFile(char* output, juce::int64 numWanted)
+		{
+			for (const auto& region : m_regions->m_regions)
+			{
+				if (region.m_offset > m_position)
+				{
+					numWanted = juce::jmin(numWanted, region.m_offset - m_position);
+				}
+			}
+
+			if (m_stream == nullptr)
+			{
+				m_stream = std::make_unique<juce::FileInputStream>(m_file);
+			}
+			if (m_stream->failedToOpen() || !m_stream->setPosition(m_position))
+			{
+				return 0;
+			}
+			return m_stream->read(output, static_cast<int>(numWanted));
+		}
+
+		juce::File m_file{};
+		std::shared_ptr<const BlockPrefetcher::Regions> m_regions{};
+		std::unique_ptr<juce::FileInputStream> m_stream{};
+		juce::int64 m_position{ 0 };
+	};
+}
+
+#if defined (JUCE_LINUX)
+// Minimal io_uring: one submission and one completion ring, mapped once and reused for every batch
+struct BlockPrefetcher::Ring
+{
+	Ring()
+	{
+		io_uring_params params{};
+		m_fd = static_cast<int>(syscall(__NR_io_uring_setup, s_queueDepth, &params));
+		if (m_fd < 0)
+		{
+			return;
+		}
+
+		m_sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		m_cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+		{
+			m_sqSize = m_cqSize = std::max(m_sqSize, m_cqSize);
+		}
+		m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+		m_sq = mmap(nullptr, m_sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+		m_cq = (params.features & IORING_FEAT_SINGLE_MMAP) ? m_sq :
+		       mmap(nullptr, m_cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+		m_sqesMapping = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+		                     IORING_OFF_SQES);
+		if (m_sq == MAP_FAILED || m_cq == MAP_FAILED || m_sqesMapping == MAP_FAILED)
+		{
+			unmap();
+			return;
+		}
+
+		auto* sq{ static_cast<char*>(m_sq) };
+		auto* cq{ static_cast<char*>(m_cq) };
+		m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		m_sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		m_sqes = static_cast<io_uring_sqe*>(m_sqesMapping);
+		m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		m_cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+	}
+
+	~Ring()
+	{
+		unmap();
+	}
+
+	void unmap()
+	{
+		if (m_sqesMapping != MAP_FAILED)
+		{
+			munmap(m_sqesMapping, m_sqesSize);
+		}
+		if (m_cq != MAP_FAILED && m_cq != m_sq)
+		{
+			munmap(m_cq, m_cqSize);
+		}
+		if (m_sq != MAP_FAILED)
+		{
+			munmap(m_sq, m_sqSize);
+		}
+		if (m_fd >= 0)
+		{
+			close(m_fd);
+		}
+		m_sq = m_cq = m_sqesMapping = MAP_FAILED;
+		m_fd = -1;
+	}
+
+	void queueRead(int fd, void* buffer, unsigned int numBytes, juce::int64 offset, juce::uint64 userData)
+	{
+		const auto tail{ *m_sqTail };
+		const auto index{ tail & *m_sqMask };
+		auto& sqe{ m_sqes[index] };
+		sqe = {};
+		sqe.opcode = IORING_OP_READ;
+		sqe.fd = fd;
+		sqe.addr = reinterpret_cast<juce::uint64>(buffer);
+		sqe.len = numBytes;
+		sqe.off = static_cast<juce::uint64>(offset);
+		sqe.user_data = userData;
+		m_sqArray[index] = index;
+		std::atomic_ref<unsigned>{ *m_sqTail }.store(tail + 1, std::memory_order_release);
+	}
+
+	// Takes back the most recently queued reads, which the kernel hasn't seen until they are submitted
+	void discardUnsubmitted(unsigned int numToDiscard)
+	{
+		std::atomic_ref<unsigned>{ *m_sqTail }.store(*m_sqTail - numToDiscard, std::memory_order_release);
+	}
+
+	// Stops using the ring without unmapping or closing it, since the kernel may still complete reads into it
+	void abandon()
+	{
+		m_sq = m_cq = m_sqesMapping = MAP_FAILED;
+		m_fd = -1;
+	}
+
+	// Number of reads the kernel took, or -1 if the ring is unusable. Returns 0 when the kernel is busy, since the
+	// completion queue has to be reaped before it takes more; busy twice in a row counts as unusable.
+	int submitAndWait(unsigned int numToSubmit)
+	{
+		for (;;)
+		{
+			const auto result{ syscall(__NR_io_uring_enter, m_fd, numToSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0) };
+			if (result >= 0)
+			{
+				m_wasBusy = false;
+				return static_cast<int>(result);
+			}
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			if ((errno == EAGAIN || errno == EBUSY) && !m_wasBusy)
+			{
+				m_wasBusy = true;
+				return 0;
+			}
+			return -1;
+		}
+	}
+
+	template<typename Function>
+	void reap(Function&& onCompletion)
+	{
+		auto head{ *m_cqHead };
+		const auto tail{ std::atomic_ref<unsigned>{ *m_cqTail }.load(std::memory_order_acquire) };
+		for (; head != tail; ++head)
+		{
+			const auto& cqe{ m_cqes[head & *m_cqMask] };
+			onCompletion(cqe.user_data, cqe.res);
+		}
+		std::atomic_ref<unsigned>{ *m_cqHead }.store(head, std::memory_order_release);
+	}
+
+	int m_fd{ -1 };
+	bool m_wasBusy{ false };
+	void* m_sq{ MAP_FAILED };
+	void* m_cq{ MAP_FAILED };
+	void* m_sqesMapping{ MAP_FAILED };
+	size_t m_sqSize{ 0 };
+	size_t m_cqSize{ 0 };
+	size_t m_sqesSize{ 0 };
+	unsigned* m_sqTail{ nullptr };
+	unsigned* m_sqMask{ nullptr };
+	unsigned* m_sqArray{ nullptr };
+	io_uring_sqe* m_sqes{ nullptr };
+	unsigned* m_cqHead{ nullptr };
+	unsigned* m_cqTail{ nullptr };
+	unsigned* m_cqMask{ nullptr };
+	io_uring_cqe* m_cqes{ nullptr };
+};
+#else
+struct BlockPrefetcher::Ring
+{
+	int m_fd{ -1 };
+};
+#endif
+
+BlockPrefetcher::BlockPrefetcher() : m_ring{ std::make_unique<Ring>() }
+{
+}
+
+BlockPrefetcher::~BlockPrefetcher() = default;
+
+bool BlockPrefetcher::isAvailable() const
+{
+	return m_ring->m_fd >= 0;
+}
+
+void BlockPrefetcher::prefetch(const std::vector<juce::File>& files)
+{
+#if defined (JUCE_LINUX)
+	if (!isAvailable())
+	{
+		return;
+	}
+	Profiler::ScopedStage stage{ Profiler::Stage::READER };
+
+	struct Read
+	{
+		size_t m_file{ 0 };
+		Region* m_region{ nullptr };
+	};
+
+	// Head and tail of each file; small files are read whole in a single region
+	std::vector<int> descriptors(files.size(), -1);
+	std::vector<std::shared_ptr<Regions>> regions(files.size());
+	std::vector<Read> reads{};
+	for (size_t index{ 0 }; index < files.size(); ++index)
+	{
+		struct stat info{};
+		descriptors[index] = open(files[index].getFullPathName().toRawUTF8(), O_RDONLY | O_CLOEXEC);
+		if (descriptors[index] < 0 || fstat(descriptors[index], &info) != 0 || info.st_size <= 0)
+		{
+			continue;
+		}
+
+		auto& fileRegions{ regions[index] = std::make_shared<Regions>() };
+		fileRegions->m_fileSize = info.st_size;
+		if (fileRegions->m_fileSize <= s_headBytes + s_tailBytes)
+		{
+			fileRegions->m_regions.push_back({ 0, juce::MemoryBlock{ static_cast<size_t>(info.st_size) } });
+		}
+		else
+		{
+			fileRegions->m_regions.push_back({ 0, juce::MemoryBlock{ static_cast<size_t>(s_headBytes) } });
+			fileRegions->m_regions.push_back({ info.st_size - s_tailBytes,
+			                                   juce::MemoryBlock{ static_cast<size_t>(s_tailBytes) } });
+		}
+
+		for (auto& region : fileRegions->m_regions)
+		{
+			reads.push_back({ index, &region });
+		}
+	}
+
+	// Keep the queue full, topping it up as completions arrive
+	std::vector<bool> failed(files.size(), false);
+	size_t numQueued{ 0 };
+	unsigned int numInFlight{ 0 };
+	unsigned int numToSubmit{ 0 };
+	auto isDraining{ false };
+	while (numQueued < reads.size() || numInFlight > 0)
+	{
+		for (; numQueued < reads.size() && numInFlight < s_queueDepth; ++numQueued, ++numInFlight, ++numToSubmit)
+		{
+			const auto& read{ reads[numQueued] };
+			m_ring->queueRead(descriptors[read.m_file], read.m_region->m_data.getData(),
+			                  static_cast<unsigned int>(read.m_region->m_data.getSize()), read.m_region->m_offset,
+			                  numQueued);
+		}
+
+		const auto numSubmitted{ m_ring->submitAndWait(numToSubmit) };
+		if (numSubmitted < 0 && !isDraining)
+		{
+			// Nothing already submitted can be trusted to have landed, so the whole batch falls back to plain reads.
+			// Reads the kernel never took are dropped, but those in flight have to finish before their buffers go.
+			std::fill(failed.begin(), failed.end(), true);
+			m_ring->discardUnsubmitted(numToSubmit);
+			numInFlight -= numToSubmit;
+			numToSubmit = 0;
+			numQueued = reads.size();
+			isDraining = true;
+			continue;
+		}
+		if (numSubmitted < 0)
+		{
+			// Can't even wait for the reads in flight, so keep their buffers alive for good and retire the ring
+			static_cast<void>(new std::vector<std::shared_ptr<Regions>>{ regions });
+			m_ring->abandon();
+			break;
+		}
+		numToSubmit -= static_cast<unsigned int>(numSubmitted);
+
+		m_ring->reap([&](juce::uint64 userData, int result)
+		{
+			--numInFlight;
+			const auto& read{ reads[static_cast<size_t>(userData)] };
+			if (result < 0)
+			{
+				failed[read.m_file] = true;
+			}
+			else
+			{
+				read.m_region->m_data.setSize(static_cast<size_t>(result));
+			}
+		});
+	}
+
+	std::scoped_lock lock{ m_mutex };
+	for (size_t index{ 0 }; index < files.size(); ++index)
+	{
+		if (descriptors[index] >= 0)
+		{
+			close(descriptors[index]);
+		}
+		if (regions[index] != nullptr && !failed[index])
+		{
+			m_files[files[index].getFullPathName()] = std::move(regions[index]);
+		}
+	}
+#else
+	juce::ignoreUnused(files);
+#endif
+}
+
+void BlockPrefetcher::release(const std::vector<juce::File>& files)
+{
+	std::scoped_lock lock{ m_mutex };
+	for (const auto& file : files)
+	{
+		m_files.erase(file.getFullPathName());
+	}
+}
+
+std::unique_ptr<juce::InputStream> BlockPrefetcher::createStream(const juce::File& file) const
+{
+	std::scoped_lock lock{ m_mutex };
+	if (const auto it{ m_files.find(file.getFullPathName()) }; it != m_files.end())
+	{
+		return std::make_unique<PrefetchedInputStream>(file, it->second);
+	}
+	return nullptr;
+}
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    prefetch.h
+    Created: 19 Oct 2026 11:38:52pm
+    Author:  Aaron Cendan
+    Description: Batched head/tail reads through io_uring, so zero searches on many small files keep the device busy
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace zero
+{
+	// Reads the head (header and first blocks) and tail (last blocks) of a batch of files with up to s_queueDepth reads
+	// in flight, instead of one synchronous read per reader seek. Readers created from createStream() are served from
+	// those buffers and only touch the file for anything in between. Needs io_uring (Linux 5.6+); where it can't be
+	// set up, isAvailable() is false and callers keep opening files directly.
+	class BlockPrefetcher
+	{
+	public:
+		static constexpr int s_headBytes{ 128 * 1024 };
+		static constexpr int s_tailBytes{ 128 * 1024 };
+		static constexpr unsigned int s_queueDepth{ 64 };
+
+		BlockPrefetcher();
+		~BlockPrefetcher();
+
+		bool isAvailable() const;
+
+		// Blocks until every read of the batch has completed; files that fail to open or read are simply left out
+		void prefetch(const std::vector<juce::File>& files);
+		void release(const std::vector<juce::File>& files);
+
+		// Stream over the prefetched regions of a file, or nullptr if it wasn't prefetched
+		std::unique_ptr<juce::InputStream> createStream(const juce::File& file) const;
+
+		struct Region
+		{
+			juce::int64 m_offset{ 0 };
+			juce::MemoryBlock m_data{};
+		};
+
+		struct Regions
+		{
+			juce::int64 m_fileSize{ 0 };
+			std::vector<Region> m_regions{};
+		};
+
+	private:
+		struct Ring;
+
+		std::unique_ptr<Ring> m_ring;
+		mutable std::mutex m_mutex{};
+		std::map<juce::String, std::shared_ptr<const Regions>> m_files{};
+	};
+}
@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+    profiler.cpp
+    Created: 19 Oct 2026 10:41:11am
+    Author:  Aaron Cendan
+    Description: Low-overhead per-thread stage timers for --profile
+
+  ==============================================================================
+*/
+
+#include "profiler.h"
+
+#include <utility>
+
+using namespace zero;
+
+namespace
+{
+	int bucketForTicks(juce::int64 ticks)
+	{
+		const auto micros{ static_cast<juce::int64>(juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6) };
+		auto bucket{ 0 };
+		for (auto upper{ static_cast<juce::int64>(1) }; micros >= upper && bucket < Profiler::s_numBuckets - 1; upper <<= 1)
+		{
+			++bucket;
+		}
+		return bucket;
+	}
+
+	void addSample(Profiler::StageTimes& times, juce::int64 ticks)
+	{
+		times.m_ticks += ticks;
+		times.m_count++;
+		times.m_maxTicks = std::max(times.m_maxTicks, ticks);
+		times.m_histogram[static_cast<size_t>(bucketForTicks(ticks))]++;
+	}
+
+	void keepSlowest(std::vector<Profiler::SlowFile>& slowest, Profiler::SlowFile file, size_t maxFiles)
+	{
+		if (maxFiles == 0)
+		{
+			return;
+		}
+
+		if (slowest.size() < maxFiles)
+		{
+			slowest.emplace_back(std::move(file));
+			return;
+		}
+
+		auto fastest{ std::min_element(slowest.begin(), slowest.end(), [](const auto& a, const auto& b)
+		{
+			return a.m_totalTicks < b.m_totalTicks;
+		}) };
+		if (fastest->m_totalTicks < file.m_totalTicks)
+		{
+			*fastest = std::move(file);
+		}
+	}
+}
+
+// Timers are only ever touched by their owning thread until report() is called after the run
+struct Profiler::ThreadTimers
+{
+	std::array<StageTimes, s_numStages> m_stages{};
+	ScopedFile* m_file{ nullptr };
+	std::vector<SlowFile> m_slowestFiles{};
+};
+
+Profiler& Profiler::get()
+{
+	static Profiler profiler{};
+	return profiler;
+}
+
+void Profiler::enable(int numSlowestFiles)
+{
+	m_numSlowestFiles = std::max(numSlowestFiles, 0);
+	m_enabled.store(true, std::memory_order_relaxed);
+}
+
+Profiler::ThreadTimers& Profiler::threadTimers()
+{
+	thread_local ThreadTimers* timers{ nullptr };
+	if (timers == nullptr)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		timers = m_threads.emplace_back(std::make_unique<ThreadTimers>()).get();
+	}
+	return *timers;
+}
+
+Profiler::Report Profiler::report() const
+{
+	std::lock_guard<std::mutex> guard(m_mutex);
+
+	Report report{};
+	for (const auto& thread : m_threads)
+	{
+		for (auto stage{ 0 }; stage < s_numStages; ++stage)
+		{
+			auto& total{ report.m_stages[static_cast<size_t>(stage)] };
+			const auto& times{ thread->m_stages[static_cast<size_t>(stage)] };
+			total.m_ticks += times.m_ticks;
+			total.m_count += times.m_count;
+			total.m_maxTicks = std::max(total.m_maxTicks, times.m_maxTicks);
+			for (auto bucket{ 0 }; bucket < s_numBuckets; ++bucket)
+			{
+				total.m_histogram[static_cast<size_t>(bucket)] += times.m_histogram[static_cast<size_t>(bucket)];
+			}
+		}
+
+		for (const auto& file : thread->m_slowestFiles)
+		{
+			keepSlowest(report.m_slowestFiles, file, static_cast<size_t>(m_numSlowestFiles));
+		}
+	}
+
+	std::sort(report.m_slowestFiles.begin(), report.m_slowestFiles.end(), [](const auto& a, const auto& b)
+	{
+		return a.m_totalTicks > b.m_totalTicks;
+	});
+	return report;
+}
+
+const char* Profiler::stageName(Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::DISCOVERY:
+		return "Discovery";
+	case Stage::READER:
+		return "Reader/header";
+	case Stage::DECODE:
+		return "Decode";
+	case Stage::COMPUTE:
+		return "Compute";
+	case Stage::OUTPUT:
+		return "Output";
+	case Stage::PROCESS:
+		return "Process";
+	}
+	return "";
+}
+
+juce::String Profiler::ticksToString(juce::int64 ticks)
+{
+	const auto seconds{ juce::Time::highResolutionTicksToSeconds(ticks) };
+	if (seconds >= 1.0)
+	{
+		return juce::String(seconds, 3) + " s";
+	}
+	if (seconds >= 1.0e-3)
+	{
+		return juce::String(seconds * 1.0e3, 3) + " ms";
+	}
+	return juce::String(seconds * 1.0e6, 1) + " us";
+}
+
+juce::String Profiler::bucketToString(int bucket)
+{
+	if (bucket == 0)
+	{
+		return "< 1 us";
+	}
+
+	const auto lower{ static_cast<juce::int64>(1) << (bucket - 1) };
+	if (bucket == s_numBuckets - 1)
+	{
+		return ">= " + ticksToString(juce::Time::secondsToHighResolutionTicks(static_cast<double>(lower) * 1.0e-6));
+	}
+	return "< " + ticksToString(juce::Time::secondsToHighResolutionTicks(static_cast<double>(lower * 2) * 1.0e-6));
+}
+
+//==============================================================================
+Profiler::ScopedStage::ScopedStage(Stage stage) : m_stage{ stage }
+{
+	if (Profiler::get().isEnabled())
+	{
+		m_file = Profiler::get().threadTimers().m_file;
+		m_start = juce::Time::getHighResolutionTicks();
+	}
+}
+
+Profiler::ScopedStage::~ScopedStage()
+{
+	if (m_start == 0)
+	{
+		return;
+	}
+
+	const auto elapsed{ juce::Time::getHighResolutionTicks() - m_start };
+	const auto stage{ static_cast<size_t>(m_stage) };
+	if (m_file != nullptr)
+	{
+		m_file->m_stageTicks[stage].fetch_add(elapsed, std::memory_order_relaxed);
+	}
+	else
+	{
+		addSample(Profiler::get().threadTimers().m_stages[stage], elapsed);
+	}
+}
+
+Profiler::ScopedFile::ScopedFile(const juce::File& file) : m_file{ file }
+{
+	if (Profiler::get().isEnabled())
+	{
+		auto& timers{ Profiler::get().threadTimers() };
+		if (timers.m_file == nullptr || timers.m_file->m_file != file)
+		{
+			m_previous = std::exchange(timers.m_file, this);
+			m_active = true;
+		}
+	}
+}
+
+Profiler::ScopedFile::~ScopedFile()
+{
+	if (!m_active)
+	{
+		return;
+	}
+
+	auto& profiler{ Profiler::get() };
+	auto& timers{ profiler.threadTimers() };
+	timers.m_file = m_previous;
+
+	SlowFile slowFile{ m_file, 0, {} };
+	for (size_t stage{ 0 }; stage < m_stageTicks.size(); ++stage)
+	{
+		if (const auto ticks{ m_stageTicks[stage].load(std::memory_order_relaxed) }; ticks > 0)
+		{
+			addSample(timers.m_stages[stage], ticks);
+			slowFile.m_stageTicks[stage] = ticks;
+			slowFile.m_totalTicks += ticks;
+		}
+	}
+	keepSlowest(timers.m_slowestFiles, std::move(slowFile), static_cast<size_t>(profiler.m_numSlowestFiles));
+}
+
+Profiler::ScopedFile* Profiler::ScopedFile::current()
+{
+	return Profiler::get().isEnabled() ? Profiler::get().threadTimers().m_file : nullptr;
+}
+
+Profiler::ScopedFile::Attach::Attach(ScopedFile* file)
+{
+	if (file != nullptr)
+	{
+		m_previous = std::exchange(Profiler::get().threadTimers().m_file, file);
+		m_active = true;
+	}
+}
+
+Profiler::ScopedFile::Attach::~Attach()
+{
+	if (m_active)
+	{
+		Profiler::get().threadTimers().m_file = m_previous;
+	}
+}
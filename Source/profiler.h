@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    profiler.h
+    Created: 19 Oct 2026 10:41:03am
+    Author:  Aaron Cendan
+    Description: Low-overhead per-thread stage timers for --profile
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+
+namespace zero
+{
+	class Profiler
+	{
+	public:
+		enum class Stage
+		{
+			DISCOVERY, READER, DECODE, COMPUTE, OUTPUT, PROCESS
+		};
+		static constexpr int s_numStages{ 6 };
+
+		// Latency histogram buckets are powers of two in microseconds, from <1us to >=2^(s_numBuckets-2)us
+		static constexpr int s_numBuckets{ 26 };
+
+		struct StageTimes
+		{
+			juce::int64 m_ticks{ 0 };
+			juce::int64 m_count{ 0 };
+			juce::int64 m_maxTicks{ 0 };
+			std::array<juce::int64, s_numBuckets> m_histogram{};
+		};
+
+		struct SlowFile
+		{
+			juce::File m_file{};
+			juce::int64 m_totalTicks{ 0 };
+			std::array<juce::int64, s_numStages> m_stageTicks{};
+		};
+
+		struct Report
+		{
+			std::array<StageTimes, s_numStages> m_stages{};
+			std::vector<SlowFile> m_slowestFiles{};
+		};
+
+		static Profiler& get();
+
+		void enable(int numSlowestFiles);
+		bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+		Report report() const;
+
+		static const char* stageName(Stage stage);
+		static juce::String ticksToString(juce::int64 ticks);
+		static juce::String bucketToString(int bucket);
+
+		class ScopedFile;
+
+		// Adds elapsed time to a stage. Inside a ScopedFile, time is attributed to that file.
+		class ScopedStage
+		{
+		public:
+			explicit ScopedStage(Stage stage);
+			~ScopedStage();
+
+		private:
+			Stage m_stage;
+			ScopedFile* m_file{ nullptr };
+			juce::int64 m_start{ 0 };
+		};
+
+		// Collects all stages timed for this file until destruction into a single per-file sample. Work done for the
+		// file on other threads is only attributed to it inside an Attach, so a task stolen from another file while
+		// this thread waits keeps its own attribution.
+		class ScopedFile
+		{
+		public:
+			explicit ScopedFile(const juce::File& file);
+			~ScopedFile();
+
+			// The file being timed on this thread, to hand to tasks that run on other threads
+			static ScopedFile* current();
+
+			// Attributes stages timed on this thread to another thread's file until destruction
+			class Attach
+			{
+			public:
+				explicit Attach(ScopedFile* file);
+				~Attach();
+
+			private:
+				ScopedFile* m_previous{ nullptr };
+				bool m_active{ false };
+			};
+
+		private:
+			friend class ScopedStage;
+
+			const juce::File& m_file;
+			ScopedFile* m_previous{ nullptr };
+			bool m_active{ false };
+			std::array<std::atomic<juce::int64>, s_numStages> m_stageTicks{};
+		};
+
+	private:
+		struct ThreadTimers;
+
+		Profiler() = default;
+
+		ThreadTimers& threadTimers();
+
+		std::atomic<bool> m_enabled{ false };
+		int m_numSlowestFiles{ 10 };
+
+		mutable std::mutex m_mutex{};
+		std::vector<std::unique_ptr<ThreadTimers>> m_threads{};
+	};
+}
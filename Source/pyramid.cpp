@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    pyramid.cpp
+    Created: 19 Oct 2026 5:05:40pm
+    Author:  Aaron Cendan
+    Description: Multi-resolution peak pyramid sidecars, so threshold re-queries skip most decoding
+
+  ==============================================================================
+*/
+
+#include "pyramid.h"
+#include "profiler.h"
+
+using namespace zero;
+
+namespace
+{
+	constexpr juce::uint32 s_sidecarMagic{ 0x5a504b50 }; // "ZPKP"
+	constexpr auto s_sidecarVersion{ 1 };
+	constexpr auto s_sidecarExtension{ ".zpk" };
+	constexpr juce::int64 s_bytesPerRange{ 3 * sizeof(float) }; // Little-endian floats, independent of struct layout
+
+	PeakRange emptyRange()
+	{
+		return { 0.0f, std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+	}
+}
+
+bool PeakPyramid::load(const juce::File& sidecar, const juce::File& audioFile, juce::int64 lengthInSamples)
+{
+	m_levels.clear();
+
+	juce::FileInputStream stream{ sidecar };
+	if (stream.failedToOpen() || static_cast<juce::uint32>(stream.readInt()) != s_sidecarMagic ||
+	    stream.readInt() != s_sidecarVersion)
+	{
+		return false;
+	}
+
+	// Stale if the audio changed since the sidecar was written
+	const auto size{ stream.readInt64() };
+	const auto modified{ stream.readInt64() };
+	if (size != audioFile.getSize() || modified != audioFile.getLastModificationTime().toMilliseconds() ||
+	    stream.readInt() != s_leafBlockSize)
+	{
+		return false;
+	}
+
+	// Checked against the reader and the bytes actually present before anything is allocated
+	const auto storedLength{ stream.readInt64() };
+	const auto numLeaves{ stream.readInt64() };
+	if (storedLength != lengthInSamples || lengthInSamples < 0 ||
+	    numLeaves != (lengthInSamples + s_leafBlockSize - 1) / s_leafBlockSize ||
+	    numLeaves > stream.getNumBytesRemaining() / s_bytesPerRange)
+	{
+		return false;
+	}
+
+	std::vector<PeakRange> leaves(static_cast<size_t>(numLeaves));
+	for (auto& leaf : leaves)
+	{
+		leaf.m_peak = stream.readFloat();
+		leaf.m_floor = stream.readFloat();
+		leaf.m_quietest = stream.readFloat();
+	}
+
+	m_lengthInSamples = lengthInSamples;
+	m_levels.push_back(std::move(leaves));
+	buildLevels();
+	return true;
+}
+
+bool PeakPyramid::save(const juce::File& sidecar, const juce::File& audioFile) const
+{
+	if (m_levels.empty())
+	{
+		return false;
+	}
+
+	sidecar.getParentDirectory().createDirectory();
+	juce::TemporaryFile temp{ sidecar };
+	{
+		juce::FileOutputStream stream{ temp.getFile() };
+		if (stream.failedToOpen())
+		{
+			return false;
+		}
+
+		// Only the leaves are stored; coarser levels are cheap to rebuild on load
+		const auto& leaves{ m_levels.front() };
+		stream.writeInt(static_cast<int>(s_sidecarMagic));
+		stream.writeInt(s_sidecarVersion);
+		stream.writeInt64(audioFile.getSize());
+		stream.writeInt64(audioFile.getLastModificationTime().toMilliseconds());
+		stream.writeInt(s_leafBlockSize);
+		stream.writeInt64(m_lengthInSamples);
+		stream.writeInt64(static_cast<juce::int64>(leaves.size()));
+		for (const auto& leaf : leaves)
+		{
+			stream.writeFloat(leaf.m_peak);
+			stream.writeFloat(leaf.m_floor);
+			stream.writeFloat(leaf.m_quietest);
+		}
+		stream.flush();
+	}
+	return temp.overwriteTargetFileWithTemporary();
+}
+
+juce::File PeakPyramid::getSidecarFile(const juce::File& audioFile, const juce::String& cacheDirectory)
+{
+	if (cacheDirectory.isEmpty())
+	{
+		return audioFile.getSiblingFile(audioFile.getFileName() + s_sidecarExtension);
+	}
+
+	// Flat cache folder, keyed by a hash of the full path so identically named files don't collide
+	const auto key{ juce::String::toHexString(audioFile.getFullPathName().hashCode64()) };
+	return juce::File::getCurrentWorkingDirectory().getChildFile(cacheDirectory)
+			.getChildFile(audioFile.getFileNameWithoutExtension() + "_" + key + s_sidecarExtension);
+}
+
+void PeakPyramid::buildLevels()
+{
+	m_levels.resize(1);
+	while (m_levels.back().size() > 1)
+	{
+		const auto& children{ m_levels.back() };
+		std::vector<PeakRange> parents((children.size() + s_branching - 1) / s_branching, emptyRange());
+		for (size_t child{ 0 }; child < children.size(); ++child)
+		{
+			auto& parent{ parents[child / s_branching] };
+			parent.m_peak = std::max(parent.m_peak, children[child].m_peak);
+			parent.m_floor = std::min(parent.m_floor, children[child].m_floor);
+			parent.m_quietest = std::min(parent.m_quietest, children[child].m_quietest);
+		}
+		m_levels.push_back(std::move(parents));
+	}
+}
+
+juce::int64 PeakPyramid::searchForward(juce::AudioFormatReader* reader, juce::Range<juce::int64> window,
+                                       float magnitudeRangeMin, float magnitudeRangeMax,
+                                       int minConsecutiveSamples) const
+{
+	return search(reader, window, false, magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples);
+}
+
+juce::int64 PeakPyramid::searchReverse(juce::AudioFormatReader* reader, juce::Range<juce::int64> window,
+                                       float magnitudeRangeMin, float magnitudeRangeMax,
+                                       int minConsecutiveSamples) const
+{
+	const auto top{ search(reader, window, true, magnitudeRangeMin, magnitudeRangeMax, minConsecutiveSamples) };
+	return (top < 0) ? -1 : m_lengthInSamples - (top + 1);
+}
+
+juce::int64 PeakPyramid::search(juce::AudioFormatReader* reader, juce::Range<juce::int64> window, bool reverse,
+                                float magnitudeRangeMin, float magnitudeRangeMax, int minConsecutiveSamples) const
+{
+	window = window.getIntersectionWith({ 0, m_lengthInSamples });
+	if (window.isEmpty() || m_levels.empty())
+	{
+		return -1;
+	}
+
+	Profiler::ScopedStage computeStage{ Profiler::Stage::COMPUTE };
+	const auto required{ static_cast<juce::int64>(std::max(minConsecutiveSamples, 1)) };
+	juce::int64 runStart{ -1 };
+	juce::int64 runLength{ 0 };
+	juce::AudioBuffer<float> buffer{ static_cast<int>(reader->numChannels), s_leafBlockSize };
+
+	// Matching samples in scan order; true once the current run reaches --consec
+	auto extend = [&](juce::int64 first, juce::int64 length)
+	{
+		if (runLength == 0)
+		{
+			runStart = first;
+		}
+		runLength += length;
+		return runLength >= required;
+	};
+
+	// Leaf blocks that straddle the thresholds are decoded and scanned sample by sample
+	auto scanLeaf = [&](juce::Range<juce::int64> span)
+	{
+		const auto numSamples{ static_cast<int>(span.getLength()) };
+		{
+			Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+			reader->read(&buffer, 0, numSamples, span.getStart(), true, true);
+		}
+
+		for (auto step{ 0 }; step < numSamples; ++step)
+		{
+			const auto index{ reverse ? numSamples - 1 - step : step };
+			auto matches{ false };
+			for (auto ch{ 0 }; ch < buffer.getNumChannels() && !matches; ++ch)
+			{
+				const auto smpl{ std::abs(buffer.getReadPointer(ch)[index]) };
+				matches = smpl >= magnitudeRangeMin && smpl <= magnitudeRangeMax;
+			}
+
+			if (!matches)
+			{
+				runLength = 0;
+			}
+			else if (extend(span.getStart() + index, 1))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	std::function<bool(size_t, size_t)> visit = [&](size_t level, size_t index)
+	{
+		const auto blockSize{ static_cast<juce::int64>(s_leafBlockSize) *
+		                      static_cast<juce::int64>(std::pow(s_branching, static_cast<double>(level))) };
+		const auto span{ juce::Range<juce::int64>(static_cast<juce::int64>(index) * blockSize,
+		                                          static_cast<juce::int64>(index + 1) * blockSize)
+				                 .getIntersectionWith(window) };
+		if (span.isEmpty())
+		{
+			return false;
+		}
+
+		// Bounds hold for any subset of the block, so clipping to the window keeps them valid
+		const auto& range{ m_levels[level][index] };
+		if (range.m_peak < magnitudeRangeMin || range.m_floor > magnitudeRangeMax)
+		{
+			runLength = 0;
+			return false;
+		}
+		if (range.m_quietest >= magnitudeRangeMin && range.m_peak <= magnitudeRangeMax)
+		{
+			return extend(reverse ? span.getEnd() - 1 : span.getStart(), span.getLength());
+		}
+		if (level == 0)
+		{
+			return scanLeaf(span);
+		}
+
+		const auto firstChild{ index * s_branching };
+		const auto numChildren{ std::min(static_cast<size_t>(s_branching), m_levels[level - 1].size() - firstChild) };
+		for (size_t step{ 0 }; step < numChildren; ++step)
+		{
+			if (visit(level - 1, firstChild + (reverse ? numChildren - 1 - step : step)))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	const auto topLevel{ m_levels.size() - 1 };
+	const auto numTopBlocks{ m_levels[topLevel].size() };
+	for (size_t step{ 0 }; step < numTopBlocks; ++step)
+	{
+		if (visit(topLevel, reverse ? numTopBlocks - 1 - step : step))
+		{
+			return runStart;
+		}
+	}
+	return -1;
+}
+
+//==============================================================================
+PyramidAnalyzer::PyramidAnalyzer(PeakPyramid& pyramid) : m_pyramid{ pyramid } { }
+
+void PyramidAnalyzer::prepare(const juce::AudioFormatReader& reader, const SearchWindows&)
+{
+	m_pyramid.m_lengthInSamples = reader.lengthInSamples;
+	m_pyramid.m_levels.assign(1, std::vector<PeakRange>(static_cast<size_t>(
+			(reader.lengthInSamples + PeakPyramid::s_leafBlockSize - 1) / PeakPyramid::s_leafBlockSize), emptyRange()));
+}
+
+void PyramidAnalyzer::process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples)
+{
+	auto& leaves{ m_pyramid.m_levels.front() };
+	const auto numChannels{ block.getNumChannels() };
+	for (auto index{ 0 }; index < numSamples; ++index)
+	{
+		auto loudest{ 0.0f };
+		auto quietest{ std::numeric_limits<float>::max() };
+		for (auto ch{ 0 }; ch < numChannels; ++ch)
+		{
+			const auto smpl{ std::abs(block.getReadPointer(ch)[index]) };
+			loudest = std::max(loudest, smpl);
+			quietest = std::min(quietest, smpl);
+		}
+
+		auto& leaf{ leaves[static_cast<size_t>((blockStart + index) / PeakPyramid::s_leafBlockSize)] };
+		leaf.m_peak = std::max(leaf.m_peak, loudest);
+		leaf.m_floor = std::min(leaf.m_floor, quietest);
+		leaf.m_quietest = std::min(leaf.m_quietest, loudest);
+	}
+}
+
+void PyramidAnalyzer::finish(File&)
+{
+	m_pyramid.buildLevels();
+}
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    pyramid.h
+    Created: 19 Oct 2026 5:05:31pm
+    Author:  Aaron Cendan
+    Description: Multi-resolution peak pyramid sidecars, so threshold re-queries skip most decoding
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "analysis.h"
+
+#include <JuceHeader.h>
+
+namespace zero
+{
+	// Magnitude bounds of one block, across all of its samples and channels
+	struct PeakRange
+	{
+		float m_peak{ 0.0f };      // Loudest magnitude on any channel
+		float m_floor{ 0.0f };     // Quietest magnitude on any channel
+		float m_quietest{ 0.0f };  // Quietest sample, taking the loudest channel of each sample
+	};
+
+	// Parameter-independent min/max pyramid; any --min/--max/--offset/--consec query classifies whole blocks
+	// as silent, loud or in range, and decodes only the leaf blocks that straddle the thresholds.
+	class PeakPyramid
+	{
+	public:
+		static constexpr auto s_leafBlockSize{ 2048 };
+		static constexpr auto s_branching{ 8 };
+
+		// Rejects sidecars that are stale, truncated or don't match the reader's length
+		bool load(const juce::File& sidecar, const juce::File& audioFile, juce::int64 lengthInSamples);
+		bool save(const juce::File& sidecar, const juce::File& audioFile) const;
+
+		// Same results as searchForLevel; forward returns the first sample of the first qualifying run,
+		// reverse returns the distance from the end of the file to the last qualifying run.
+		juce::int64 searchForward(juce::AudioFormatReader* reader, juce::Range<juce::int64> window,
+		                          float magnitudeRangeMin, float magnitudeRangeMax, int minConsecutiveSamples) const;
+		juce::int64 searchReverse(juce::AudioFormatReader* reader, juce::Range<juce::int64> window,
+		                          float magnitudeRangeMin, float magnitudeRangeMax, int minConsecutiveSamples) const;
+
+		static juce::File getSidecarFile(const juce::File& audioFile, const juce::String& cacheDirectory);
+
+	private:
+		friend class PyramidAnalyzer;
+		void buildLevels();
+
+		juce::int64 search(juce::AudioFormatReader* reader, juce::Range<juce::int64> window, bool reverse,
+		                   float magnitudeRangeMin, float magnitudeRangeMax, int minConsecutiveSamples) const;
+
+		juce::int64 m_lengthInSamples{ 0 };
+		std::vector<std::vector<PeakRange>> m_levels{};
+	};
+
+	// Builds a pyramid from a full decode pass; the search windows are ignored
+	class PyramidAnalyzer : public Analyzer
+	{
+	public:
+		explicit PyramidAnalyzer(PeakPyramid& pyramid);
+
+		void prepare(const juce::AudioFormatReader& reader, const SearchWindows& windows) override;
+		void process(const juce::AudioBuffer<float>& block, juce::int64 blockStart, int numSamples) override;
+		void finish(File& file) override;
+
+	private:
+		PeakPyramid& m_pyramid;
+	};
+}
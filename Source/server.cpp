@@ -0,0 +1,486 @@
+/*
+  ==============================================================================
+
+    server.cpp
+    Created: 19 Oct 2026 9:57:03pm
+    Author:  Aaron Cendan
+    Description: Unix domain socket server and client for --serve/--client, answering from a warm worker pool
+
+  ==============================================================================
+*/
+
+#include "server.h"
+#include "literals.h"
+
+#if !defined (JUCE_WINDOWS)
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <thread>
+
+using namespace zero;
+
+namespace
+{
+	constexpr auto s_maxRequestBytes{ 16 * 1024 * 1024 };
+	constexpr auto s_listenBacklog{ 64 };
+	constexpr auto s_connectionTimeoutSeconds{ 30 };
+	constexpr auto s_acceptBackoffMilliseconds{ 100 };
+
+#if !defined (JUCE_WINDOWS)
+	bool toAddress(const juce::File& socket, sockaddr_un& address)
+	{
+		const auto path{ socket.getFullPathName().toStdString() };
+		if (path.size() >= sizeof(address.sun_path))
+		{
+			return false;
+		}
+
+		address = {};
+		address.sun_family = AF_UNIX;
+		std::copy(path.begin(), path.end(), address.sun_path);
+		return true;
+	}
+
+	// Returns a connected descriptor, or -1 if nothing is listening at the address
+	int connectTo(const sockaddr_un& address)
+	{
+		const auto connection{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+		if (connection >= 0 && connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			close(connection);
+			return -1;
+		}
+		return connection;
+	}
+
+	// Paths are read with the server's permissions, so only its own user may send them
+	bool isSameUser(int connection)
+	{
+#if defined (JUCE_LINUX)
+		ucred credentials{};
+		socklen_t size{ sizeof(credentials) };
+		return getsockopt(connection, SOL_SOCKET, SO_PEERCRED, &credentials, &size) == 0 &&
+		       credentials.uid == geteuid();
+#else
+		uid_t uid{};
+		gid_t gid{};
+		return getpeereid(connection, &uid, &gid) == 0 && uid == geteuid();
+#endif
+	}
+
+	// A client that connects and then goes quiet must not hold a thread and a descriptor forever
+	void setTimeouts(int connection)
+	{
+		timeval timeout{};
+		timeout.tv_sec = s_connectionTimeoutSeconds;
+		setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	}
+
+	// Reads up to the first newline, or until the peer stops writing
+	std::optional<juce::String> readLine(int descriptor)
+	{
+		juce::MemoryBlock data{};
+		char buffer[4096];
+		for (;;)
+		{
+			const auto numBytes{ recv(descriptor, buffer, sizeof(buffer), 0) };
+			if (numBytes < 0)
+			{
+				return std::nullopt;
+			}
+
+			const auto* newline{ static_cast<const char*>(std::memchr(buffer, '\n', static_cast<size_t>(numBytes))) };
+			data.append(buffer, newline ? static_cast<size_t>(newline - buffer) : static_cast<size_t>(numBytes));
+			if (newline != nullptr || numBytes == 0)
+			{
+				break;
+			}
+			if (data.getSize() > static_cast<size_t>(s_maxRequestBytes))
+			{
+				return std::nullopt;
+			}
+		}
+		return juce::String::fromUTF8(static_cast<const char*>(data.getData()), static_cast<int>(data.getSize()));
+	}
+
+	bool writeLine(int descriptor, const juce::String& line)
+	{
+		const auto text{ (line + "\n").toStdString() };
+		for (size_t sent{ 0 }; sent < text.size();)
+		{
+			const auto numBytes{ ::send(descriptor, text.data() + sent, text.size() - sent, 0) };
+			if (numBytes <= 0)
+			{
+				return false;
+			}
+			sent += static_cast<size_t>(numBytes);
+		}
+		return true;
+	}
+#endif
+
+	juce::var toVar(const lib::Result& result, const lib::Options& options)
+	{
+		auto* obj{ new juce::DynamicObject() };
+		obj->setProperty("path", result.m_name);
+		obj->setProperty("valid", result.m_valid);
+		if (result.m_valid)
+		{
+			obj->setProperty("sampleRate", result.m_sampleRate);
+			obj->setProperty("channels", result.m_numChannels);
+			obj->setProperty("length", result.m_lengthInSamples);
+		}
+		if (result.m_valid && (options.m_analyses & lib::ZERO))
+		{
+			obj->setProperty("firstNonZero", result.m_firstNonZeroSample);
+			obj->setProperty("lastNonZero", result.m_lastNonZeroSample);
+		}
+		if (result.m_valid && (options.m_analyses & lib::MONO))
+		{
+			obj->setProperty("monoCompatibility", result.m_monoCompatibility);
+		}
+		if (result.m_valid && (options.m_analyses & lib::LEVEL))
+		{
+			obj->setProperty("peak", result.m_peak);
+			obj->setProperty("rms", result.m_rms);
+			obj->setProperty("dcOffset", result.m_dcOffset);
+			obj->setProperty("clipped", result.m_numClippedSamples);
+		}
+		return obj;
+	}
+
+	juce::String toError(const juce::String& message)
+	{
+		auto* obj{ new juce::DynamicObject() };
+		obj->setProperty("error", message);
+		return juce::JSON::toString(juce::var{ obj }, true);
+	}
+}
+
+Server::Server(const juce::File& socket, const juce::String& fileExtensions) :
+		m_socket{ socket }, m_fileExtensions{ fileExtensions }
+{
+}
+
+Server::~Server()
+{
+#if !defined (JUCE_WINDOWS)
+	if (m_listener >= 0)
+	{
+		close(m_listener);
+		m_socket.deleteFile();
+	}
+#endif
+}
+
+bool Server::listen()
+{
+#if !defined (JUCE_WINDOWS)
+	sockaddr_un address{};
+	if (!toAddress(m_socket, address))
+	{
+		return false;
+	}
+
+	// Clients hanging up early must not kill the server
+	std::signal(SIGPIPE, SIG_IGN);
+
+	// A socket left behind by a server that didn't shut down cleanly would block bind(), but a live one is left alone
+	if (m_socket.exists())
+	{
+		if (const auto connection{ connectTo(address) }; connection >= 0)
+		{
+			close(connection);
+			return false;
+		}
+		m_socket.deleteFile();
+	}
+
+	// Owner-only from the moment bind() creates it, so other users never get a window to connect
+	m_listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	const auto previousMask{ umask(0077) };
+	const auto isBound{ m_listener >= 0 &&
+	                    bind(m_listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 };
+	umask(previousMask);
+
+	if (!isBound || chmod(address.sun_path, S_IRUSR | S_IWUSR) != 0 || ::listen(m_listener, s_listenBacklog) != 0)
+	{
+		if (m_listener >= 0)
+		{
+			close(m_listener);
+			m_listener = -1;
+		}
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Server::run()
+{
+#if !defined (JUCE_WINDOWS)
+	while (m_listener >= 0)
+	{
+		// Further connections wait in the listen backlog until a slot frees up
+		m_connections.acquire();
+		const auto connection{ accept(m_listener, nullptr, nullptr) };
+		if (connection < 0)
+		{
+			m_connections.release();
+			const auto error{ errno };
+			if (error == EINTR || error == ECONNABORTED)
+			{
+				continue;
+			}
+
+			// Out of descriptors or memory; back off rather than spin until connections in flight close
+			if (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(s_acceptBackoffMilliseconds));
+				continue;
+			}
+			break;
+		}
+
+		// Each connection waits on its own thread while the shared pool does the analysis
+		setTimeouts(connection);
+		std::thread{ [this, connection]
+		{
+			serve(connection);
+			m_connections.release();
+		} }.detach();
+	}
+
+	// Connections still in flight use this server, so wait for them before returning
+	for (auto slot{ 0 }; slot < s_maxConnections; ++slot)
+	{
+		m_connections.acquire();
+	}
+#endif
+}
+
+void Server::serve(int connection) const
+{
+#if !defined (JUCE_WINDOWS)
+	if (!isSameUser(connection))
+	{
+		writeLine(connection, toError("Requests are only answered for the user running the server"));
+	}
+	else if (const auto request{ readLine(connection) })
+	{
+		writeLine(connection, respond(*request));
+	}
+	close(connection);
+#else
+	juce::ignoreUnused(connection);
+#endif
+}
+
+juce::String Server::respond(const juce::String& request) const
+{
+	const auto json{ juce::JSON::parse(request) };
+	if (!json.isObject())
+	{
+		return toError("Request is not a JSON object");
+	}
+
+	lib::Options options{};
+	options.m_analyses = 0;
+	if (const auto* analyses{ json["analyses"].getArray() })
+	{
+		for (const auto& analysis : *analyses)
+		{
+			const auto name{ analysis.toString().trim() };
+			options.m_analyses |= name.equalsIgnoreCase("zero") ? lib::ZERO :
+			                      name.equalsIgnoreCase("mono") ? lib::MONO :
+			                      name.equalsIgnoreCase("level") ? lib::LEVEL : 0;
+		}
+	}
+	if (options.m_analyses == 0)
+	{
+		options.m_analyses = lib::ZERO;
+	}
+
+	options.m_startSampleOffset = static_cast<juce::int64>(json.getProperty("offset", options.m_startSampleOffset));
+	options.m_numSamplesToSearch = static_cast<juce::int64>(json.getProperty("num", options.m_numSamplesToSearch));
+	options.m_magnitudeRangeMin = std::clamp(static_cast<double>(json.getProperty("min", options.m_magnitudeRangeMin)),
+	                                         0.0, 1.0);
+	options.m_magnitudeRangeMax = std::clamp(static_cast<double>(json.getProperty("max", options.m_magnitudeRangeMax)),
+	                                         0.0, 1.0);
+	options.m_minConsecutiveSamples = static_cast<int>(json.getProperty("consec", options.m_minConsecutiveSamples));
+	if (options.m_magnitudeRangeMin >= options.m_magnitudeRangeMax)
+	{
+		return toError("min must be less than max");
+	}
+
+	// Paths are resolved by the server, so clients should send absolute paths
+	std::vector<lib::Input> inputs{};
+	if (const auto* files{ json["files"].getArray() })
+	{
+		for (const auto& path : *files)
+		{
+			const juce::File file{ juce::File::getCurrentWorkingDirectory().getChildFile(path.toString()) };
+			if (file.isDirectory())
+			{
+				for (const auto& child : file.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true))
+				{
+					if (child.hasFileExtension(m_fileExtensions))
+					{
+						inputs.push_back({ child.getFullPathName(), child });
+					}
+				}
+			}
+			else
+			{
+				inputs.push_back({ file.getFullPathName(), file });
+			}
+		}
+	}
+
+	juce::Array<juce::var> results{};
+	for (const auto& result : lib::analyze(inputs, options))
+	{
+		results.add(toVar(result, options));
+	}
+
+	auto* response{ new juce::DynamicObject() };
+	response->setProperty("results", results);
+	return juce::JSON::toString(juce::var{ response }, true);
+}
+
+juce::File Server::getDefaultSocket()
+{
+	return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("zerochecker.sock");
+}
+
+juce::String Server::createRequest(const juce::StringArray& paths, const lib::Options& options)
+{
+	juce::Array<juce::var> files{};
+	for (const auto& path : paths)
+	{
+		files.add(path);
+	}
+
+	juce::Array<juce::var> analyses{};
+	for (const auto& [analysis, name] : { std::pair{ lib::ZERO, "zero" }, std::pair{ lib::MONO, "mono" },
+	                                      std::pair{ lib::LEVEL, "level" } })
+	{
+		if (options.m_analyses & analysis)
+		{
+			analyses.add(name);
+		}
+	}
+
+	auto* request{ new juce::DynamicObject() };
+	request->setProperty("files", files);
+	request->setProperty("analyses", analyses);
+	request->setProperty("offset", options.m_startSampleOffset);
+	request->setProperty("num", options.m_numSamplesToSearch);
+	request->setProperty("min", options.m_magnitudeRangeMin);
+	request->setProperty("max", options.m_magnitudeRangeMax);
+	request->setProperty("consec", options.m_minConsecutiveSamples);
+	return juce::JSON::toString(juce::var{ request }, true);
+}
+
+std::optional<juce::String> Server::send(const juce::File& socket, const juce::String& request)
+{
+#if !defined (JUCE_WINDOWS)
+	sockaddr_un address{};
+	if (!toAddress(socket, address))
+	{
+		return std::nullopt;
+	}
+
+	const auto connection{ connectTo(address) };
+	if (connection < 0)
+	{
+		return std::nullopt;
+	}
+
+	std::optional<juce::String> response{};
+	if (writeLine(connection, request))
+	{
+		response = readLine(connection);
+	}
+	close(connection);
+	return response;
+#else
+	juce::ignoreUnused(socket, request);
+	return std::nullopt;
+#endif
+}
+
+int Server::runClient(const juce::ArgumentList& args)
+{
+	// Same options as a local scan: --analyze picks the analyses, otherwise --mono or zerochecking does
+	lib::Options options{};
+	options.m_analyses = args.containsOption("-m|--mono") ? lib::MONO : lib::ZERO;
+	if (args.containsOption("-a|--analyze"))
+	{
+		auto analyses{ 0 };
+		for (const auto& name : juce::StringArray::fromTokens(args.getValueForOption("-a|--analyze"), ",", ""))
+		{
+			analyses |= name.trim().equalsIgnoreCase("zero") ? lib::ZERO :
+			            name.trim().equalsIgnoreCase("mono") ? lib::MONO :
+			            name.trim().equalsIgnoreCase("level") ? lib::LEVEL : 0;
+		}
+		options.m_analyses = (analyses != 0) ? analyses : options.m_analyses;
+	}
+	if (args.containsOption("-o|--offset"))
+	{
+		options.m_startSampleOffset = args.getValueForOption("-o|--offset").getLargeIntValue();
+	}
+	if (args.containsOption("-n|--num"))
+	{
+		options.m_numSamplesToSearch = args.getValueForOption("-n|--num").getLargeIntValue();
+	}
+	if (args.containsOption("-y|--min"))
+	{
+		options.m_magnitudeRangeMin = std::clamp(args.getValueForOption("-y|--min").getDoubleValue(), 0.0, 1.0);
+	}
+	if (args.containsOption("-x|--max"))
+	{
+		options.m_magnitudeRangeMax = std::clamp(args.getValueForOption("-x|--max").getDoubleValue(), 0.0, 1.0);
+	}
+	if (args.containsOption("-s|--consec"))
+	{
+		options.m_minConsecutiveSamples = args.getValueForOption("-s|--consec").getIntValue();
+	}
+
+	// The server has its own working directory, so send absolute paths. Like a local scan, only existing folders and
+	// audio files count, which also leaves out the values of options such as -o 100.
+	juce::StringArray paths{};
+	for (const auto& arg : args.arguments)
+	{
+		const auto file{ arg.resolveAsFile() };
+		if (!arg.isOption() && (file.isDirectory() ||
+		                        (file.existsAsFile() && file.hasFileExtension(ltrl::audioFileExtensions))))
+		{
+			paths.add(file.getFullPathName());
+		}
+	}
+
+	const auto value{ args.getValueForOption("--client").trim() };
+	const auto socket{ value.isEmpty() ? getDefaultSocket() : juce::File::getCurrentWorkingDirectory().getChildFile(value) };
+	const auto response{ send(socket, createRequest(paths, options)) };
+	if (!response.has_value())
+	{
+		juce::ConsoleApplication::fail("No zerochecker server on " + socket.getFullPathName());
+	}
+	if (const auto json{ juce::JSON::parse(*response) }; json.hasProperty("error"))
+	{
+		juce::ConsoleApplication::fail("zerochecker server: " + json["error"].toString());
+	}
+
+	std::cout << *response << ltrl::endl;
+	return 0;
+}
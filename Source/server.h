@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    server.h
+    Created: 19 Oct 2026 9:57:03pm
+    Author:  Aaron Cendan
+    Description: Unix domain socket server and client for --serve/--client, answering from a warm worker pool
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../Library/Source/libzerochecker.h"
+
+#include <JuceHeader.h>
+#include <optional>
+#include <semaphore>
+
+namespace zero
+{
+	// One newline-terminated JSON request per connection, answered with one newline-terminated JSON response:
+	//   {"files":["/a.wav","/folder"],"analyses":["zero","mono"],"offset":0,"num":-1,"min":0.003,"max":1.0,"consec":0}
+	//   {"results":[{"path":"/a.wav","valid":true,"firstNonZero":12,...}]}  or  {"error":"..."}
+	// Formats, readers and the thread pool stay alive between requests, so small batches skip all startup costs.
+	class Server
+	{
+	public:
+		Server(const juce::File& socket, const juce::String& fileExtensions);
+		~Server();
+
+		bool listen();
+
+		// Only returns if accepting connections fails for a reason other than running short of descriptors
+		void run();
+
+		juce::String respond(const juce::String& request) const;
+
+		static juce::File getDefaultSocket();
+		static juce::String createRequest(const juce::StringArray& paths, const lib::Options& options);
+		static std::optional<juce::String> send(const juce::File& socket, const juce::String& request);
+
+		// Handles --client without building a Checker, since the server already has formats and workers warm
+		static int runClient(const juce::ArgumentList& args);
+
+	private:
+		void serve(int connection) const;
+
+		juce::File m_socket{};
+		juce::String m_fileExtensions{};
+		int m_listener{ -1 };
+
+		static constexpr auto s_maxConnections{ 64 };
+		std::counting_semaphore<> m_connections{ s_maxConnections };
+	};
+}
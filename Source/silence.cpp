@@ -0,0 +1,415 @@
+/*
+  ==============================================================================
+
+    silence.cpp
+    Created: 20 Oct 2026 12:14:07am
+    Author:  Aaron Cendan
+    Description: Raw-byte scan for exact digital zero at either end of uncompressed PCM, skipping sparse file holes
+
+  ==============================================================================
+*/
+
+#include "silence.h"
+#include "profiler.h"
+
+#if !defined (JUCE_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace zero;
+
+namespace
+{
+	// Scans start inside the prefetched head and tail, then grow so long stretches of silence take few reads
+	constexpr auto s_firstScanBlockSize{ 1 << 16 };
+	constexpr auto s_scanBlockSize{ 1 << 20 };
+	constexpr auto s_maxChunks{ 64 };
+
+	// Byte range and frame size of the sample data
+	struct PcmLayout
+	{
+		juce::Range<juce::int64> m_data{};
+		int m_bytesPerFrame{ 0 };
+	};
+
+	bool hasId(const char* id, const char* expected)
+	{
+		return std::memcmp(id, expected, 4) == 0;
+	}
+
+	// RIFF/RF64/BW64 WAVE; RF64 data sizes come from the ds64 chunk
+	std::optional<PcmLayout> readWavLayout(juce::InputStream& stream, const char* riffId)
+	{
+		const auto isRf64{ !hasId(riffId, "RIFF") };
+		std::optional<juce::int64> ds64DataSize{};
+		std::optional<juce::int64> dataStart{};
+		juce::int64 dataSize{ 0 };
+		auto bytesPerFrame{ 0 };
+
+		for (auto numChunks{ 0 }; numChunks < s_maxChunks && !stream.isExhausted(); ++numChunks)
+		{
+			char id[4]{};
+			if (stream.read(id, 4) != 4)
+			{
+				break;
+			}
+			const auto size{ static_cast<juce::int64>(static_cast<juce::uint32>(stream.readInt())) };
+			const auto chunkStart{ stream.getPosition() };
+
+			if (hasId(id, "ds64") && isRf64)
+			{
+				stream.readInt64();
+				ds64DataSize = stream.readInt64();
+			}
+			else if (hasId(id, "fmt "))
+			{
+				auto formatTag{ static_cast<juce::uint16>(stream.readShort()) };
+				stream.skipNextBytes(10);
+				const auto blockAlign{ static_cast<juce::uint16>(stream.readShort()) };
+				const auto bitsPerSample{ static_cast<juce::uint16>(stream.readShort()) };
+				if (formatTag == 0xfffe && size >= 40)
+				{
+					// WAVE_FORMAT_EXTENSIBLE keeps the real tag at the start of the subformat GUID
+					stream.skipNextBytes(8);
+					formatTag = static_cast<juce::uint16>(stream.readShort());
+				}
+				if ((formatTag != 1 && formatTag != 3) || bitsPerSample < 16)
+				{
+					return std::nullopt;
+				}
+				bytesPerFrame = blockAlign;
+			}
+			else if (hasId(id, "data"))
+			{
+				dataStart = chunkStart;
+				dataSize = (isRf64 && ds64DataSize.has_value() && size == 0xffffffff) ? *ds64DataSize : size;
+				break;
+			}
+
+			stream.setPosition(chunkStart + size + (size & 1));
+		}
+
+		if (!dataStart.has_value() || bytesPerFrame <= 0)
+		{
+			return std::nullopt;
+		}
+		return PcmLayout{ { *dataStart, *dataStart + dataSize }, bytesPerFrame };
+	}
+
+	// Wave64 chunks are 16-byte GUIDs whose first four bytes match the RIFF ids, with 64-bit sizes including the header
+	std::optional<PcmLayout> readW64Layout(juce::InputStream& stream)
+	{
+		stream.setPosition(40);
+		auto bytesPerFrame{ 0 };
+		for (auto numChunks{ 0 }; numChunks < s_maxChunks && !stream.isExhausted(); ++numChunks)
+		{
+			char guid[16]{};
+			if (stream.read(guid, 16) != 16)
+			{
+				break;
+			}
+			const auto size{ stream.readInt64() };
+			const auto chunkStart{ stream.getPosition() - 24 };
+			if (size < 24)
+			{
+				break;
+			}
+
+			if (hasId(guid, "fmt "))
+			{
+				const auto formatTag{ static_cast<juce::uint16>(stream.readShort()) };
+				stream.skipNextBytes(10);
+				bytesPerFrame = static_cast<juce::uint16>(stream.readShort());
+				const auto bitsPerSample{ static_cast<juce::uint16>(stream.readShort()) };
+				if ((formatTag != 1 && formatTag != 3) || bitsPerSample < 16)
+				{
+					return std::nullopt;
+				}
+			}
+			else if (hasId(guid, "data"))
+			{
+				if (bytesPerFrame <= 0)
+				{
+					return std::nullopt;
+				}
+				return PcmLayout{ { chunkStart + 24, chunkStart + size }, bytesPerFrame };
+			}
+
+			stream.setPosition(chunkStart + ((size + 7) & ~static_cast<juce::int64>(7)));
+		}
+		return std::nullopt;
+	}
+
+	// AIFF, or AIFF-C with uncompressed big/little-endian PCM or float
+	std::optional<PcmLayout> readAiffLayout(juce::InputStream& stream, bool isAifc)
+	{
+		auto bytesPerFrame{ 0 };
+		for (auto numChunks{ 0 }; numChunks < s_maxChunks && !stream.isExhausted(); ++numChunks)
+		{
+			char id[4]{};
+			if (stream.read(id, 4) != 4)
+			{
+				break;
+			}
+			const auto size{ static_cast<juce::int64>(static_cast<juce::uint32>(stream.readIntBigEndian())) };
+			const auto chunkStart{ stream.getPosition() };
+
+			if (hasId(id, "COMM"))
+			{
+				const auto numChannels{ static_cast<int>(stream.readShortBigEndian()) };
+				stream.skipNextBytes(4);
+				const auto bitsPerSample{ static_cast<int>(stream.readShortBigEndian()) };
+				stream.skipNextBytes(10);
+				if (isAifc)
+				{
+					char compression[4]{};
+					stream.read(compression, 4);
+					if (!hasId(compression, "NONE") && !hasId(compression, "sowt") && !hasId(compression, "fl32") &&
+					    !hasId(compression, "FL32"))
+					{
+						return std::nullopt;
+					}
+				}
+				if (bitsPerSample < 16 || numChannels <= 0)
+				{
+					return std::nullopt;
+				}
+				bytesPerFrame = numChannels * ((bitsPerSample + 7) / 8);
+			}
+			else if (hasId(id, "SSND"))
+			{
+				const auto offset{ static_cast<juce::int64>(static_cast<juce::uint32>(stream.readIntBigEndian())) };
+				if (bytesPerFrame <= 0 || size < 8 + offset)
+				{
+					return std::nullopt;
+				}
+				return PcmLayout{ { chunkStart + 8 + offset, chunkStart + size }, bytesPerFrame };
+			}
+
+			stream.setPosition(chunkStart + size + (size & 1));
+		}
+		return std::nullopt;
+	}
+
+	std::optional<PcmLayout> readLayout(juce::InputStream& stream)
+	{
+		char riffId[4]{};
+		if (stream.read(riffId, 4) != 4)
+		{
+			return std::nullopt;
+		}
+
+		std::optional<PcmLayout> layout{};
+		if (hasId(riffId, "RIFF") || hasId(riffId, "RF64") || hasId(riffId, "BW64"))
+		{
+			char waveId[4]{};
+			stream.skipNextBytes(4);
+			if (stream.read(waveId, 4) == 4 && hasId(waveId, "WAVE"))
+			{
+				layout = readWavLayout(stream, riffId);
+			}
+		}
+		else if (hasId(riffId, "riff"))
+		{
+			layout = readW64Layout(stream);
+		}
+		else if (hasId(riffId, "FORM"))
+		{
+			char formType[4]{};
+			stream.skipNextBytes(4);
+			if (stream.read(formType, 4) == 4 && (hasId(formType, "AIFF") || hasId(formType, "AIFC")))
+			{
+				layout = readAiffLayout(stream, hasId(formType, "AIFC"));
+			}
+		}
+
+		// Truncated exports declare more data than they hold
+		if (layout.has_value())
+		{
+			layout->m_data = layout->m_data.getIntersectionWith({ 0, stream.getTotalLength() });
+		}
+		return layout;
+	}
+
+	// Ranges of the file backed by data; holes in sparse files read as zeros and are left out
+	std::vector<juce::Range<juce::int64>> findDataExtents(const juce::File& file, juce::Range<juce::int64> range)
+	{
+#if !defined (JUCE_WINDOWS) && defined (SEEK_DATA) && defined (SEEK_HOLE)
+		const auto fd{ open(file.getFullPathName().toRawUTF8(), O_RDONLY | O_CLOEXEC) };
+		if (fd >= 0)
+		{
+			std::vector<juce::Range<juce::int64>> extents{};
+			auto position{ range.getStart() };
+			while (position < range.getEnd())
+			{
+				const auto dataStart{ static_cast<juce::int64>(lseek(fd, position, SEEK_DATA)) };
+				if (dataStart < 0 || dataStart >= range.getEnd())
+				{
+					// ENXIO: nothing but hole up to the end of the file
+					break;
+				}
+				const auto holeStart{ static_cast<juce::int64>(lseek(fd, dataStart, SEEK_HOLE)) };
+				const auto dataEnd{ (holeStart < 0) ? range.getEnd() : juce::jmin(holeStart, range.getEnd()) };
+				extents.emplace_back(dataStart, dataEnd);
+				position = dataEnd;
+			}
+
+			// Filesystems without hole support report one extent for the whole file, which is equally correct
+			close(fd);
+			return extents;
+		}
+#else
+		juce::ignoreUnused(file);
+#endif
+		return { range };
+	}
+
+	// Offset of the first non-zero byte, or size if there is none
+	size_t findFirstNonZero(const juce::uint8* data, size_t size)
+	{
+		size_t index{ 0 };
+		for (; index + sizeof(juce::uint64) <= size; index += sizeof(juce::uint64))
+		{
+			juce::uint64 word{};
+			std::memcpy(&word, data + index, sizeof(word));
+			if (word != 0)
+			{
+				break;
+			}
+		}
+		for (; index < size; ++index)
+		{
+			if (data[index] != 0)
+			{
+				return index;
+			}
+		}
+		return size;
+	}
+
+	// One past the last non-zero byte, or 0 if there is none
+	size_t findLastNonZero(const juce::uint8* data, size_t size)
+	{
+		auto end{ size };
+		for (; end >= sizeof(juce::uint64); end -= sizeof(juce::uint64))
+		{
+			juce::uint64 word{};
+			std::memcpy(&word, data + end - sizeof(word), sizeof(word));
+			if (word != 0)
+			{
+				break;
+			}
+		}
+		for (; end > 0; --end)
+		{
+			if (data[end - 1] != 0)
+			{
+				return end;
+			}
+		}
+		return 0;
+	}
+
+	// File position of the first non-zero byte in the extents, or the end of the data if all of it is zero
+	juce::int64 scanForward(juce::InputStream& stream, const std::vector<juce::Range<juce::int64>>& extents,
+	                        juce::int64 dataEnd)
+	{
+		juce::HeapBlock<juce::uint8> block{ static_cast<size_t>(s_scanBlockSize) };
+		auto blockSize{ s_firstScanBlockSize };
+		for (const auto& extent : extents)
+		{
+			for (auto position{ extent.getStart() }; position < extent.getEnd();)
+			{
+				const auto numBytes{ static_cast<int>(juce::jmin(extent.getEnd() - position,
+				                                                 static_cast<juce::int64>(blockSize))) };
+				stream.setPosition(position);
+				const auto numRead{ stream.read(block.get(), numBytes) };
+				const auto first{ findFirstNonZero(block.get(), static_cast<size_t>(juce::jmax(numRead, 0))) };
+				if (first < static_cast<size_t>(juce::jmax(numRead, 0)) || numRead < numBytes)
+				{
+					return position + static_cast<juce::int64>(first);
+				}
+				position += numBytes;
+				blockSize = juce::jmin(blockSize * 2, s_scanBlockSize);
+			}
+		}
+		return dataEnd;
+	}
+
+	// File position one past the last non-zero byte in the extents, or the start of the data if all of it is zero
+	juce::int64 scanReverse(juce::InputStream& stream, const std::vector<juce::Range<juce::int64>>& extents,
+	                        juce::int64 dataStart)
+	{
+		juce::HeapBlock<juce::uint8> block{ static_cast<size_t>(s_scanBlockSize) };
+		auto blockSize{ s_firstScanBlockSize };
+		for (auto extent{ extents.rbegin() }; extent != extents.rend(); ++extent)
+		{
+			for (auto end{ extent->getEnd() }; end > extent->getStart();)
+			{
+				const auto position{ juce::jmax(extent->getStart(), end - blockSize) };
+				const auto numBytes{ static_cast<int>(end - position) };
+				stream.setPosition(position);
+				if (stream.read(block.get(), numBytes) != numBytes)
+				{
+					return end;
+				}
+				if (const auto last{ findLastNonZero(block.get(), static_cast<size_t>(numBytes)) }; last > 0)
+				{
+					return position + static_cast<juce::int64>(last);
+				}
+				end = position;
+				blockSize = juce::jmin(blockSize * 2, s_scanBlockSize);
+			}
+		}
+		return dataStart;
+	}
+}
+
+std::optional<DigitalSilence> DigitalSilence::scan(const juce::File& file, juce::InputStream& stream)
+{
+	Profiler::ScopedStage stage{ Profiler::Stage::DECODE };
+
+	// Readers such as FLAC's keep track of their own position in the stream
+	struct PositionRestorer
+	{
+		~PositionRestorer() { m_stream.setPosition(m_position); }
+
+		juce::InputStream& m_stream;
+		juce::int64 m_position{ 0 };
+	} restorer{ stream, stream.getPosition() };
+
+	stream.setPosition(0);
+	const auto layout{ readLayout(stream) };
+	if (!layout.has_value() || layout->m_data.isEmpty())
+	{
+		return std::nullopt;
+	}
+
+	const auto& data{ layout->m_data };
+	const auto extents{ findDataExtents(file, data) };
+	const auto firstNonZero{ scanForward(stream, extents, data.getEnd()) };
+
+	DigitalSilence silence{};
+	silence.m_numSamples = data.getLength() / layout->m_bytesPerFrame;
+	silence.m_numLeadingSamples = (firstNonZero - data.getStart()) / layout->m_bytesPerFrame;
+	if (firstNonZero >= data.getEnd())
+	{
+		silence.m_numLeadingSamples = silence.m_numSamples;
+		silence.m_numTrailingSamples = silence.m_numSamples;
+		return silence;
+	}
+
+	// Only the extents after the first non-zero byte can hold the last one
+	std::vector<juce::Range<juce::int64>> tail{};
+	for (const auto& extent : extents)
+	{
+		if (extent.getEnd() > firstNonZero)
+		{
+			tail.emplace_back(juce::jmax(extent.getStart(), firstNonZero), extent.getEnd());
+		}
+	}
+	const auto lastNonZeroEnd{ scanReverse(stream, tail, firstNonZero) };
+	silence.m_numTrailingSamples = (data.getEnd() - lastNonZeroEnd) / layout->m_bytesPerFrame;
+	return silence;
+}
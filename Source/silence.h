@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    silence.h
+    Created: 20 Oct 2026 12:14:07am
+    Author:  Aaron Cendan
+    Description: Raw-byte scan for exact digital zero at either end of uncompressed PCM, skipping sparse file holes
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <optional>
+
+namespace zero
+{
+	// Leading and trailing frames of exact digital zero in a WAV/RF64/W64/AIFF data chunk, found without decoding:
+	// holes in sparse files are skipped with SEEK_DATA/SEEK_HOLE where supported, and everything else is compared
+	// eight bytes at a time. Zero bytes are silence in every byte order for signed PCM and float, but not for
+	// unsigned 8-bit or companded data, so those formats aren't scanned.
+	struct DigitalSilence
+	{
+		juce::int64 m_numSamples{ 0 };
+		juce::int64 m_numLeadingSamples{ 0 };
+		juce::int64 m_numTrailingSamples{ 0 };
+
+		bool isSilent() const { return m_numLeadingSamples >= m_numSamples; }
+
+		// nullopt if the file isn't a format whose raw zero bytes can be trusted. Bytes come from stream, normally the
+		// reader's own input so prefetched heads and tails are reused, and its position is restored afterwards; the
+		// file itself is only asked where its holes are.
+		static std::optional<DigitalSilence> scan(const juce::File& file, juce::InputStream& stream);
+	};
+}
@@ -0,0 +1,367 @@
+/*
+  ==============================================================================
+
+    w64.cpp
+    Created: 19 Oct 2026 7:48:10pm
+    Author:  Aaron Cendan
+    Description: Sony Wave64 (.w64) reader and writer, for multi-hour recordings past the 4 GB RIFF limit
+
+  ==============================================================================
+*/
+
+#include "w64.h"
+
+using namespace zero;
+
+namespace
+{
+	using Guid = std::array<juce::uint8, 16>;
+
+	constexpr Guid s_riffGuid{ 0x72, 0x69, 0x66, 0x66, 0x2e, 0x91, 0xcf, 0x11,
+	                           0xa5, 0xd6, 0x28, 0xdb, 0x04, 0xc1, 0x00, 0x00 };
+	constexpr Guid s_waveGuid{ 0x77, 0x61, 0x76, 0x65, 0xf3, 0xac, 0xd3, 0x11,
+	                           0x8c, 0xd1, 0x00, 0xc0, 0x4f, 0x8e, 0xdb, 0x8a };
+	constexpr Guid s_fmtGuid{ 0x66, 0x6d, 0x74, 0x20, 0xf3, 0xac, 0xd3, 0x11,
+	                          0x8c, 0xd1, 0x00, 0xc0, 0x4f, 0x8e, 0xdb, 0x8a };
+	constexpr Guid s_dataGuid{ 0x64, 0x61, 0x74, 0x61, 0xf3, 0xac, 0xd3, 0x11,
+	                           0x8c, 0xd1, 0x00, 0xc0, 0x4f, 0x8e, 0xdb, 0x8a };
+
+	constexpr auto s_formatName{ "Wave64 file" };
+	constexpr auto s_chunkHeaderSize{ 24 };
+	constexpr auto s_fmtChunkSize{ s_chunkHeaderSize + 16 };
+	constexpr auto s_headerSize{ 40 + s_fmtChunkSize + s_chunkHeaderSize };
+	constexpr juce::uint16 s_formatPcm{ 1 };
+	constexpr juce::uint16 s_formatFloat{ 3 };
+	constexpr juce::uint16 s_formatExtensible{ 0xfffe };
+	constexpr auto s_readBlockFrames{ 4096 };
+
+	bool readGuid(juce::InputStream& stream, Guid& guid)
+	{
+		return stream.read(guid.data(), static_cast<int>(guid.size())) == static_cast<int>(guid.size());
+	}
+
+	juce::int64 padToEight(juce::int64 size)
+	{
+		return (size + 7) & ~static_cast<juce::int64>(7);
+	}
+
+	//==============================================================================
+	class W64Reader : public juce::AudioFormatReader
+	{
+	public:
+		explicit W64Reader(juce::InputStream* stream) : juce::AudioFormatReader(stream, s_formatName)
+		{
+			Guid guid{};
+			if (!readGuid(*input, guid) || guid != s_riffGuid)
+			{
+				return;
+			}
+			input->readInt64();
+			if (!readGuid(*input, guid) || guid != s_waveGuid)
+			{
+				return;
+			}
+
+			// Walk the chunks, which are 8-byte aligned and sized including their own 24-byte header
+			auto hasFormat{ false };
+			while (!input->isExhausted() && readGuid(*input, guid))
+			{
+				const auto chunkSize{ input->readInt64() };
+				const auto chunkStart{ input->getPosition() };
+				if (chunkSize < s_chunkHeaderSize)
+				{
+					return;
+				}
+
+				if (guid == s_fmtGuid)
+				{
+					auto formatTag{ static_cast<juce::uint16>(input->readShort()) };
+					numChannels = static_cast<unsigned int>(input->readShort());
+					sampleRate = static_cast<unsigned int>(input->readInt());
+					input->readInt(); // Bytes per second
+					m_bytesPerFrame = static_cast<juce::uint16>(input->readShort());
+					bitsPerSample = static_cast<unsigned int>(input->readShort());
+
+					if (formatTag == s_formatExtensible && chunkSize >= s_chunkHeaderSize + 40)
+					{
+						input->readShort(); // Extension size
+						input->readShort(); // Valid bits
+						input->readInt();   // Channel mask
+						formatTag = static_cast<juce::uint16>(input->readShort());
+					}
+
+					usesFloatingPointData = (formatTag == s_formatFloat);
+					hasFormat = (formatTag == s_formatPcm || formatTag == s_formatFloat) && numChannels > 0 &&
+					            m_bytesPerFrame == static_cast<int>(numChannels * (bitsPerSample / 8));
+				}
+				else if (guid == s_dataGuid)
+				{
+					m_dataStart = chunkStart;
+					m_dataLength = chunkSize - s_chunkHeaderSize;
+					break;
+				}
+
+				input->setPosition(chunkStart - s_chunkHeaderSize + padToEight(chunkSize));
+			}
+
+			if (hasFormat && m_dataStart > 0)
+			{
+				lengthInSamples = m_dataLength / m_bytesPerFrame;
+			}
+			else
+			{
+				numChannels = 0;
+			}
+		}
+
+		bool isValid() const { return numChannels > 0 && m_bytesPerFrame > 0; }
+
+		bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+		                 juce::int64 startSampleInFile, int numSamples) override
+		{
+			clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+			                                  startSampleInFile, numSamples, lengthInSamples);
+			if (numSamples <= 0)
+			{
+				return true;
+			}
+
+			input->setPosition(m_dataStart + startSampleInFile * m_bytesPerFrame);
+			while (numSamples > 0)
+			{
+				const auto numThisTime{ std::min(numSamples, s_readBlockFrames) };
+				m_block.setSize(static_cast<size_t>(numThisTime) * m_bytesPerFrame, false);
+				const auto numBytes{ input->read(m_block.getData(), static_cast<int>(m_block.getSize())) };
+				const auto numFrames{ numBytes / m_bytesPerFrame };
+				convert(destChannels, numDestChannels, startOffsetInDestBuffer, numFrames);
+
+				// Zero the remainder of a truncated file rather than leave stale data behind
+				for (auto ch{ 0 }; ch < numDestChannels; ++ch)
+				{
+					if (destChannels[ch] != nullptr && numFrames < numThisTime)
+					{
+						std::fill(destChannels[ch] + startOffsetInDestBuffer + numFrames,
+						          destChannels[ch] + startOffsetInDestBuffer + numSamples, 0);
+					}
+				}
+				if (numFrames < numThisTime)
+				{
+					break;
+				}
+
+				startOffsetInDestBuffer += numThisTime;
+				numSamples -= numThisTime;
+			}
+			return true;
+		}
+
+	private:
+		// JUCE's integer convention is left-justified 32-bit; float data is passed through as raw float bits
+		void convert(int* const* destChannels, int numDestChannels, int destOffset, int numFrames) const
+		{
+			const auto* data{ static_cast<const juce::uint8*>(m_block.getData()) };
+			const auto bytesPerSample{ static_cast<int>(bitsPerSample / 8) };
+			for (auto ch{ 0 }; ch < numDestChannels; ++ch)
+			{
+				auto* dest{ destChannels[ch] };
+				if (dest == nullptr)
+				{
+					continue;
+				}
+				dest += destOffset;
+
+				if (ch >= static_cast<int>(numChannels))
+				{
+					std::fill(dest, dest + numFrames, 0);
+					continue;
+				}
+
+				for (auto frame{ 0 }; frame < numFrames; ++frame)
+				{
+					const auto* smpl{ data + frame * m_bytesPerFrame + ch * bytesPerSample };
+					dest[frame] = decode(smpl);
+				}
+			}
+		}
+
+		int decode(const juce::uint8* smpl) const
+		{
+			if (usesFloatingPointData)
+			{
+				float value{ 0.0f };
+				if (bitsPerSample == 64)
+				{
+					double wide{ 0.0 };
+					std::memcpy(&wide, smpl, sizeof(wide));
+					value = static_cast<float>(wide);
+				}
+				else
+				{
+					std::memcpy(&value, smpl, sizeof(value));
+				}
+
+				int bits{ 0 };
+				std::memcpy(&bits, &value, sizeof(bits));
+				return bits;
+			}
+
+			switch (bitsPerSample)
+			{
+			case 8:
+				return (static_cast<int>(smpl[0]) - 128) << 24;
+			case 16:
+				return static_cast<int>(juce::ByteOrder::littleEndianShort(smpl)) << 16;
+			case 24:
+				return juce::ByteOrder::littleEndian24Bit(smpl) << 8;
+			case 32:
+				return static_cast<int>(juce::ByteOrder::littleEndianInt(smpl));
+			default:
+				return 0;
+			}
+		}
+
+		juce::int64 m_dataStart{ 0 };
+		juce::int64 m_dataLength{ 0 };
+		int m_bytesPerFrame{ 0 };
+		juce::MemoryBlock m_block{};
+	};
+
+	//==============================================================================
+	class W64Writer : public juce::AudioFormatWriter
+	{
+	public:
+		W64Writer(juce::OutputStream* stream, double rate, unsigned int channels, unsigned int bits) :
+				juce::AudioFormatWriter(stream, s_formatName, rate, channels, bits)
+		{
+			usesFloatingPointData = (bits == 32);
+			m_headerPosition = output->getPosition();
+			writeHeader();
+		}
+
+		~W64Writer() override
+		{
+			// Pad the data chunk to 8 bytes and patch the sizes now that the length is known
+			const auto dataSize{ m_numFramesWritten * bytesPerFrame() };
+			output->writeRepeatedByte(0, static_cast<size_t>(padToEight(dataSize) - dataSize));
+			writeHeader();
+			output->flush();
+		}
+
+		bool write(const int** data, int numSamples) override
+		{
+			const auto bytesPerSample{ static_cast<int>(bitsPerSample / 8) };
+			m_block.setSize(static_cast<size_t>(numSamples) * bytesPerFrame(), false);
+			auto* out{ static_cast<juce::uint8*>(m_block.getData()) };
+
+			for (auto frame{ 0 }; frame < numSamples; ++frame)
+			{
+				for (auto ch{ 0 }; ch < static_cast<int>(numChannels); ++ch)
+				{
+					const auto value{ (data[ch] != nullptr) ? data[ch][frame] : 0 };
+					auto* smpl{ out + (frame * static_cast<int>(numChannels) + ch) * bytesPerSample };
+					encode(value, smpl);
+				}
+			}
+
+			m_numFramesWritten += numSamples;
+			return output->write(m_block.getData(), m_block.getSize());
+		}
+
+	private:
+		juce::int64 bytesPerFrame() const
+		{
+			return static_cast<juce::int64>(numChannels) * (bitsPerSample / 8);
+		}
+
+		void encode(int value, juce::uint8* smpl) const
+		{
+			// Float writers receive raw float bits, integer writers left-justified 32-bit samples
+			const auto bits{ static_cast<juce::uint32>(value) };
+			switch (bitsPerSample)
+			{
+			case 16:
+				smpl[0] = static_cast<juce::uint8>(bits >> 16);
+				smpl[1] = static_cast<juce::uint8>(bits >> 24);
+				break;
+			case 24:
+				smpl[0] = static_cast<juce::uint8>(bits >> 8);
+				smpl[1] = static_cast<juce::uint8>(bits >> 16);
+				smpl[2] = static_cast<juce::uint8>(bits >> 24);
+				break;
+			default:
+				for (auto byte{ 0 }; byte < 4; ++byte)
+				{
+					smpl[byte] = static_cast<juce::uint8>(bits >> (byte * 8));
+				}
+				break;
+			}
+		}
+
+		void writeHeader()
+		{
+			const auto dataSize{ m_numFramesWritten * bytesPerFrame() };
+			output->setPosition(m_headerPosition);
+
+			output->write(s_riffGuid.data(), s_riffGuid.size());
+			output->writeInt64(s_headerSize + padToEight(dataSize));
+			output->write(s_waveGuid.data(), s_waveGuid.size());
+
+			output->write(s_fmtGuid.data(), s_fmtGuid.size());
+			output->writeInt64(s_fmtChunkSize);
+			output->writeShort(static_cast<short>(usesFloatingPointData ? s_formatFloat : s_formatPcm));
+			output->writeShort(static_cast<short>(numChannels));
+			output->writeInt(static_cast<int>(sampleRate));
+			output->writeInt(static_cast<int>(sampleRate * static_cast<double>(bytesPerFrame())));
+			output->writeShort(static_cast<short>(bytesPerFrame()));
+			output->writeShort(static_cast<short>(bitsPerSample));
+
+			output->write(s_dataGuid.data(), s_dataGuid.size());
+			output->writeInt64(s_chunkHeaderSize + dataSize);
+			output->setPosition(m_headerPosition + s_headerSize + padToEight(dataSize));
+		}
+
+		juce::int64 m_headerPosition{ 0 };
+		juce::int64 m_numFramesWritten{ 0 };
+		juce::MemoryBlock m_block{};
+	};
+}
+
+//==============================================================================
+W64AudioFormat::W64AudioFormat() : juce::AudioFormat(s_formatName, juce::StringArray(".w64")) { }
+
+juce::Array<int> W64AudioFormat::getPossibleSampleRates()
+{
+	return { 8000, 11025, 16000, 22050, 32000, 44100, 48000, 88200, 96000, 176400, 192000, 352800, 384000 };
+}
+
+juce::Array<int> W64AudioFormat::getPossibleBitDepths()
+{
+	return { 16, 24, 32 };
+}
+
+juce::AudioFormatReader* W64AudioFormat::createReaderFor(juce::InputStream* sourceStream,
+                                                         bool deleteStreamIfOpeningFails)
+{
+	auto reader{ std::make_unique<W64Reader>(sourceStream) };
+	if (reader->isValid())
+	{
+		return reader.release();
+	}
+
+	if (!deleteStreamIfOpeningFails)
+	{
+		reader->input = nullptr;
+	}
+	return nullptr;
+}
+
+juce::AudioFormatWriter* W64AudioFormat::createWriterFor(juce::OutputStream* streamToWriteTo,
+                                                         double sampleRateToUse, unsigned int numberOfChannels,
+                                                         int bitsPerSample, const juce::StringPairArray&, int)
+{
+	if (streamToWriteTo == nullptr || numberOfChannels == 0 || !getPossibleBitDepths().contains(bitsPerSample))
+	{
+		return nullptr;
+	}
+	return new W64Writer(streamToWriteTo, sampleRateToUse, numberOfChannels, static_cast<unsigned int>(bitsPerSample));
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    w64.h
+    Created: 19 Oct 2026 7:48:02pm
+    Author:  Aaron Cendan
+    Description: Sony Wave64 (.w64) reader and writer, for multi-hour recordings past the 4 GB RIFF limit
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+namespace zero
+{
+	// Wave64 is RIFF/WAVE with 16-byte GUID chunk ids and 64-bit chunk sizes; PCM 8-32 bit and float 32/64 are read,
+	// PCM 16/24 bit and float 32 are written
+	class W64AudioFormat : public juce::AudioFormat
+	{
+	public:
+		W64AudioFormat();
+
+		juce::Array<int> getPossibleSampleRates() override;
+		juce::Array<int> getPossibleBitDepths() override;
+		bool canDoStereo() override { return true; }
+		bool canDoMono() override { return true; }
+
+		juce::AudioFormatReader* createReaderFor(juce::InputStream* sourceStream,
+		                                         bool deleteStreamIfOpeningFails) override;
+		juce::AudioFormatWriter* createWriterFor(juce::OutputStream* streamToWriteTo, double sampleRateToUse,
+		                                         unsigned int numberOfChannels, int bitsPerSample,
+		                                         const juce::StringPairArray& metadataValues,
+		                                         int qualityOptionIndex) override;
+	};
+}
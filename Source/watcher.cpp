@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    watcher.cpp
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  Aaron Cendan
+    Description: Folder watcher for --watch, reporting audio files once they finish writing
+
+  ==============================================================================
+*/
+
+#include "watcher.h"
+
+#if defined (JUCE_LINUX)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace zero;
+
+namespace
+{
+#if defined (JUCE_LINUX)
+	constexpr auto s_eventBufferSize{ 16384 };
+	constexpr juce::uint32 s_folderEvents{ IN_CLOSE_WRITE | IN_MOVED_TO | IN_MODIFY | IN_CREATE };
+#endif
+}
+
+Watcher::Watcher(const juce::Array<juce::File>& folders, const juce::String& fileExtensions, int settleMilliseconds) :
+		m_fileExtensions{ fileExtensions }, m_settleMilliseconds{ std::max(settleMilliseconds, 0) }
+{
+#if defined (JUCE_LINUX)
+	// Out of instances (fs.inotify.max_user_instances) or unsupported, so poll instead
+	m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	m_lastScanMs = juce::Time::currentTimeMillis();
+#endif
+
+	for (const auto& folder : folders)
+	{
+		if (folder.isDirectory())
+		{
+			addFolder(folder);
+		}
+	}
+}
+
+Watcher::~Watcher()
+{
+#if defined (JUCE_LINUX)
+	if (m_inotify >= 0)
+	{
+		close(m_inotify);
+	}
+#endif
+}
+
+std::vector<juce::File> Watcher::waitForFiles(int timeoutMilliseconds)
+{
+	if (isPolling())
+	{
+		juce::Thread::sleep(timeoutMilliseconds);
+		pollFolders();
+	}
+	else
+	{
+		readEvents(timeoutMilliseconds);
+	}
+
+	// Exporters may reopen a file to patch its header, so wait until it has been quiet and its size is stable
+	std::vector<juce::File> ready{};
+	const auto now{ juce::Time::currentTimeMillis() };
+	for (auto it{ m_pending.begin() }; it != m_pending.end();)
+	{
+		const juce::File file{ it->first };
+		auto& pending{ it->second };
+		if (!file.existsAsFile())
+		{
+			it = m_pending.erase(it);
+			continue;
+		}
+
+		if (now - pending.m_lastChangeMs >= m_settleMilliseconds)
+		{
+			if (const auto size{ file.getSize() }; size != pending.m_size)
+			{
+				pending = { now, size };
+			}
+			else
+			{
+				ready.push_back(file);
+				it = m_pending.erase(it);
+				continue;
+			}
+		}
+		++it;
+	}
+	return ready;
+}
+
+void Watcher::addFolder(const juce::File& folder)
+{
+	m_folders.addIfNotAlreadyThere(folder);
+
+#if defined (JUCE_LINUX)
+	if (!isPolling())
+	{
+		// inotify isn't recursive, so every subfolder needs its own watch
+		const auto descriptor{ inotify_add_watch(m_inotify, folder.getFullPathName().toRawUTF8(), s_folderEvents) };
+		if (descriptor >= 0)
+		{
+			m_watchDescriptors[descriptor] = folder;
+		}
+
+		for (const auto& child : folder.findChildFiles(juce::File::TypesOfFileToFind::findDirectories, false))
+		{
+			addFolder(child);
+		}
+		return;
+	}
+#endif
+
+	// Existing files are only reported once they change
+	for (const auto& child : folder.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true))
+	{
+		if (matches(child))
+		{
+			m_modificationTimes[child.getFullPathName()] = child.getLastModificationTime().toMilliseconds();
+		}
+	}
+}
+
+void Watcher::touch(const juce::File& file)
+{
+	m_pending[file.getFullPathName()] = { juce::Time::currentTimeMillis(), file.getSize() };
+}
+
+void Watcher::readEvents(int timeoutMilliseconds)
+{
+#if defined (JUCE_LINUX)
+	pollfd descriptor{ m_inotify, POLLIN, 0 };
+	if (m_inotify < 0 || poll(&descriptor, 1, timeoutMilliseconds) <= 0)
+	{
+		return;
+	}
+
+	alignas(inotify_event) char buffer[s_eventBufferSize];
+	auto overflowed{ false };
+	for (;;)
+	{
+		const auto numBytes{ read(m_inotify, buffer, sizeof(buffer)) };
+		if (numBytes <= 0)
+		{
+			break;
+		}
+
+		for (auto offset{ 0 }; offset < numBytes;)
+		{
+			const auto* event{ reinterpret_cast<const inotify_event*>(buffer + offset) };
+			offset += static_cast<int>(sizeof(inotify_event) + event->len);
+
+			// The kernel queue filled up during a burst and events were dropped
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				overflowed = true;
+				continue;
+			}
+
+			const auto folder{ m_watchDescriptors.find(event->wd) };
+			if (folder == m_watchDescriptors.end())
+			{
+				continue;
+			}
+			if (event->mask & IN_IGNORED)
+			{
+				m_watchDescriptors.erase(folder);
+				continue;
+			}
+			if (event->len == 0)
+			{
+				continue;
+			}
+
+			const auto child{ folder->second.getChildFile(event->name) };
+			if (event->mask & IN_ISDIR)
+			{
+				// Files can land in a new folder before its watch exists, so pick up whatever is already there
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					addFolder(child);
+					for (const auto& file : child.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true))
+					{
+						if (matches(file))
+						{
+							touch(file);
+						}
+					}
+				}
+			}
+			else if (matches(child))
+			{
+				// Writes only postpone files that are already pending; closing or moving in is what queues them
+				if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO) || m_pending.count(child.getFullPathName()) > 0)
+				{
+					touch(child);
+				}
+			}
+		}
+	}
+
+	if (overflowed)
+	{
+		rescanFolders();
+	}
+#else
+	juce::ignoreUnused(timeoutMilliseconds);
+#endif
+}
+
+void Watcher::pollFolders()
+{
+	for (const auto& folder : m_folders)
+	{
+		for (const auto& child : folder.findChildFiles(juce::File::TypesOfFileToFind::findFiles, true))
+		{
+			if (!matches(child))
+			{
+				continue;
+			}
+
+			const auto modified{ child.getLastModificationTime().toMilliseconds() };
+			auto& known{ m_modificationTimes[child.getFullPathName()] };
+			if (known != modified)
+			{
+				known = modified;
+				touch(child);
+			}
+		}
+	}
+}
+
+void Watcher::rescanFolders()
+{
+#if defined (JUCE_LINUX)
+	// Anything written since the last scan may have lost its events, and so may new subfolders and their watches
+	const auto scanStart{ juce::Time::currentTimeMillis() };
+	for (auto index{ 0 }; index < m_folders.size(); ++index)
+	{
+		const auto folder{ m_folders[index] };
+		for (const auto& child : folder.findChildFiles(juce::File::TypesOfFileToFind::findDirectories, false))
+		{
+			if (!m_folders.contains(child))
+			{
+				addFolder(child);
+			}
+		}
+
+		for (const auto& child : folder.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false))
+		{
+			if (matches(child) && child.getLastModificationTime().toMilliseconds() >= m_lastScanMs)
+			{
+				touch(child);
+			}
+		}
+	}
+	m_lastScanMs = scanStart;
+#endif
+}
+
+bool Watcher::isPolling() const
+{
+#if defined (JUCE_LINUX)
+	return m_inotify < 0;
+#else
+	return true;
+#endif
+}
+
+bool Watcher::matches(const juce::File& file) const
+{
+	return file.hasFileExtension(m_fileExtensions);
+}
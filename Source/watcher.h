@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    watcher.h
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  Aaron Cendan
+    Description: Folder watcher for --watch, reporting audio files once they finish writing
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+
+namespace zero
+{
+	// Recursively watches folders for new or modified files with the given extensions. Uses inotify on Linux and falls
+	// back to polling modification times elsewhere, or when inotify is unavailable. A file is only reported once it has
+	// been closed (or left untouched) for the settle time, so exports still in progress are never picked up half-written.
+	class Watcher
+	{
+	public:
+		Watcher(const juce::Array<juce::File>& folders, const juce::String& fileExtensions, int settleMilliseconds);
+		~Watcher();
+
+		bool isWatching() const { return !m_folders.isEmpty(); }
+
+		// Blocks for up to timeoutMilliseconds, returning files that finished writing since the last call
+		std::vector<juce::File> waitForFiles(int timeoutMilliseconds);
+
+	private:
+		struct Pending
+		{
+			juce::int64 m_lastChangeMs{ 0 };
+			juce::int64 m_size{ -1 };
+		};
+
+		void addFolder(const juce::File& folder);
+		void touch(const juce::File& file);
+		void readEvents(int timeoutMilliseconds);
+		void pollFolders();
+		void rescanFolders();
+		bool isPolling() const;
+		bool matches(const juce::File& file) const;
+
+		juce::Array<juce::File> m_folders{};
+		juce::String m_fileExtensions{};
+		int m_settleMilliseconds{ 0 };
+		std::map<juce::String, Pending> m_pending{};
+
+#if defined (JUCE_LINUX)
+		int m_inotify{ -1 };
+		std::map<int, juce::File> m_watchDescriptors{};
+		juce::int64 m_lastScanMs{ 0 };
+#endif
+		std::map<juce::String, juce::int64> m_modificationTimes{};
+	};
+}
@@ -11,33 +11,66 @@
 #include "zerochecker.h"
 #include "console.h"
 #include "literals.h"
+#include "analysis.h"
+#include "alignment.h"
+#include "fingerprint.h"
+#include "loudness.h"
+#include "pyramid.h"
+#include "flacindex.h"
+#include "server.h"
+#include "w64.h"
+#include "watcher.h"
 
 #include <execution>
+#include <future>
+#include <regex>
+#include <semaphore>
 
 using namespace zero;
 
 namespace
 {
-	auto getWavFlacWriter(const juce::File& file, const juce::AudioFormatReader& reader,
-	                      const int numChannels) -> std::unique_ptr<juce::AudioFormatWriter>
+	constexpr auto s_processBlockSize{ 65536 };
+	constexpr auto s_alignmentWindowSize{ 65536 };
+	constexpr auto s_minDuplicateSimilarity{ 0.5f };
+	constexpr auto s_watchPollMilliseconds{ 250 };
+	constexpr auto s_prefetchBatchSize{ 128 };
+	constexpr auto s_defaultProfileFiles{ 10 };
+
+	auto getAudioFormatWriter(const juce::File& file, const juce::AudioFormatReader& reader,
+	                          const int numChannels) -> std::unique_ptr<juce::AudioFormatWriter>
 	{
 		auto makeWriter = [&](auto& format)
 		{
+			// Fall back to 24-bit where the source depth can't be written, e.g. 8-bit or 64-bit float into W64
+			const auto bitsPerSample{ format.getPossibleBitDepths().contains(static_cast<int>(reader.bitsPerSample)) ?
+			                          static_cast<int>(reader.bitsPerSample) : 24 };
 			std::unique_ptr<juce::AudioFormatWriter> writer{ format.createWriterFor(
 					new juce::FileOutputStream(file),
-					reader.sampleRate, numChannels, reader.bitsPerSample, reader.metadataValues, 0) };
-			return std::move(writer);
+					reader.sampleRate, numChannels, bitsPerSample, reader.metadataValues, 0) };
+			return writer;
 		};
 
-		if (file.hasFileExtension("wav"))
+		// RF64 is handled by the WAV writer, which switches to a ds64 header once data passes 4 GB
+		if (file.hasFileExtension("wav;bwf;rf64"))
 		{
 			juce::WavAudioFormat format;
-			return std::move(makeWriter(format));
+			return makeWriter(format);
 		}
 		else if (file.hasFileExtension("flac"))
 		{
 			juce::FlacAudioFormat format;
-			return std::move(makeWriter(format));
+			return makeWriter(format);
+		}
+		else if (file.hasFileExtension("aif;aiff"))
+		{
+			juce::AiffAudioFormat format;
+			return makeWriter(format);
+		}
+		else if (file.hasFileExtension("w64"))
+		{
+			W64AudioFormat format;
+			return makeWriter(format);
 		}
 		else
 		{
@@ -45,21 +78,54 @@ namespace
 		}
 	}
 
-	void eraseFileContents(juce::FileOutputStream& fileStream)
+	// Streams a range of the reader into a new file block by block, so memory use doesn't depend on file length
+	bool writeRange(juce::AudioFormatReader& reader, const juce::File& file, juce::Range<juce::int64> range,
+	                const int numChannels)
 	{
-		fileStream.setPosition(0);
-		fileStream.truncate();
+		auto writer{ getAudioFormatWriter(file, reader, numChannels) };
+		if (writer == nullptr)
+		{
+			return false;
+		}
+
+		juce::AudioBuffer<float> buffer{ numChannels, s_processBlockSize };
+		for (auto pos{ range.getStart() }; pos < range.getEnd(); pos += s_processBlockSize)
+		{
+			const auto numThisTime{ static_cast<int>(juce::jmin(range.getEnd() - pos,
+			                                                    static_cast<juce::int64>(s_processBlockSize))) };
+			reader.read(&buffer, 0, numThisTime, pos, true, numChannels > 1);
+			if (!writer->writeFromAudioSampleBuffer(buffer, 0, numThisTime))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Rewrites a file in place through a temporary sibling, since the reader still streams from the original
+	bool rewriteRange(std::unique_ptr<juce::AudioFormatReader> reader, const juce::File& file,
+	                  juce::Range<juce::int64> range, const int numChannels)
+	{
+		juce::TemporaryFile temp{ file };
+		if (!writeRange(*reader, temp.getFile(), range, numChannels))
+		{
+			return false;
+		}
+
+		reader.reset();
+		return temp.overwriteTargetFileWithTemporary();
 	}
 }
 
 Checker::Checker()
 {
 	m_formatMngr.registerBasicFormats();
+	m_formatMngr.registerFormat(new W64AudioFormat(), false);
 
 	// Parse input files
 	m_files.cmd = juce::ConsoleApplication::Command(
 			{ "", "<files> <folders>", "Files and/or folders to analyze",
-			  "Recursively analyzes all .wav and .flac files in folders.",
+			  "Recursively analyzes all .wav, .flac, .aif(f), .w64 and .rf64 files in folders.",
 			  [this](const juce::ArgumentList& args)
 			  {
 				  for (const auto& arg : args.arguments)
@@ -69,13 +135,16 @@ Checker::Checker()
 					  {
 						  for (const auto& child : file.findChildFiles(
 								  juce::File::TypesOfFileToFind::findFiles, true,
-								  "*.wav;*.flac"))
+								  ltrl::audioFileWildcard))
 						  {
-							  m_files.val.emplace_back(child);
+							  if (isInShard(child.getRelativePathFrom(file)))
+							  {
+								  m_files.val.emplace_back(child);
+							  }
 						  }
 					  }
 					  else if (file.existsAsFile() &&
-					           file.hasFileExtension("wav;flac"))
+					           file.hasFileExtension(ltrl::audioFileExtensions) && isInShard(file.getFileName()))
 					  {
 						  m_files.val.emplace_back(file);
 					  }
@@ -96,10 +165,252 @@ Checker::Checker()
 			  }});
 	addCommand(m_monoAnalysisThreshold.cmd);
 
+	// Combined analysis mode
+	m_analyses.cmd = juce::ConsoleApplication::Command(
+			{ "-a|--analyze", "-a|--analyze <zero,mono,level>",
+			  "Run several analyses in one pass. Comma-separated list of: zero, mono, level",
+			  "Decodes each file once and merges zerochecker, monochecker and level metrics (peak, RMS, DC offset, clipping) into a single row.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto names{ juce::StringArray::fromTokens(args.getValueForOption("-a|--analyze"), ",", "") };
+				  for (const auto& name : names)
+				  {
+					  const auto trimmed{ name.trim() };
+					  if (trimmed.equalsIgnoreCase("zero"))
+					  {
+						  m_analyses.val |= Analysis::ZERO;
+					  }
+					  else if (trimmed.equalsIgnoreCase("mono"))
+					  {
+						  m_analyses.val |= Analysis::MONO;
+					  }
+					  else if (trimmed.equalsIgnoreCase("level"))
+					  {
+						  m_analyses.val |= Analysis::LEVEL;
+					  }
+				  }
+
+				  if (m_analyses.val != 0)
+				  {
+					  m_analysisMode = AnalysisMode::MULTI_ANALYSIS;
+				  }
+			  }});
+	addCommand(m_analyses.cmd);
+
+	// Loop seam analysis mode
+	m_loopWindowSize.cmd = juce::ConsoleApplication::Command(
+			{ "-l|--loop", "-l|--loop <1024>",
+			  "Loop click-risk analysis. Window size in samples at the head and tail of each file.",
+			  "Overrides zerochecking to compare only the boundaries of looping files for clicks at the seam.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_analysisMode = AnalysisMode::LOOP_CHECKER;
+				  m_loopWindowSize.val = std::max(args.getValueForOption("-l|--loop").getIntValue(), 0);
+				  if (m_loopWindowSize.val == 0)
+				  {
+					  m_loopWindowSize.val = 1024;
+				  }
+			  }});
+	addCommand(m_loopWindowSize.cmd);
+
+	// Gap segmentation mode
+	m_minGapMilliseconds.cmd = juce::ConsoleApplication::Command(
+			{ "-g|--gaps", "-g|--gaps <500>",
+			  "Gap segmentation. Minimum duration of internal silence (ms) that splits a file into regions.",
+			  "Overrides zerochecking to list every sound region separated by silent gaps, using the --min/--max/--consec thresholds.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_analysisMode = AnalysisMode::GAP_SEGMENTER;
+				  m_minGapMilliseconds.val = std::max(args.getValueForOption("-g|--gaps").getDoubleValue(), 0.0);
+				  if (m_minGapMilliseconds.val <= 0.0)
+				  {
+					  m_minGapMilliseconds.val = 500.0;
+				  }
+			  }});
+	addCommand(m_minGapMilliseconds.cmd);
+
+	// Group alignment mode
+	m_alignPattern.cmd = juce::ConsoleApplication::Command(
+			{ "--align", "--align=<folder|pattern>",
+			  "Alignment offsets within groups of synchronized files, grouped by folder or by a regex pattern.",
+			  "Overrides zerochecking to cross-correlate the onset of each file against the first file in its group. A pattern like '_(en|fr|de)$' is removed from file names to form the group.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto pattern{ args.getValueForOption("--align").trim() };
+				  try
+				  {
+					  [[maybe_unused]] const std::regex regex{ pattern.toStdString() };
+				  }
+				  catch (const std::regex_error&)
+				  {
+					  juce::ConsoleApplication::fail("Invalid --align pattern: " + pattern);
+				  }
+
+				  m_analysisMode = AnalysisMode::ALIGNMENT_CHECKER;
+				  m_alignPattern.val = pattern.isEmpty() ? juce::String("folder") : pattern;
+			  }});
+	addCommand(m_alignPattern.cmd);
+
+	// Near-duplicate detection mode
+	m_fingerprintIndex.cmd = juce::ConsoleApplication::Command(
+			{ "--dupes", "--dupes=<index.zfp>",
+			  "Near-duplicate detection. Path of the fingerprint index, created if missing and updated after each run.",
+			  "Overrides zerochecking to fingerprint each file in one pass and list near-duplicates (gain changes, trims, re-exports) across everything in the index.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_analysisMode = AnalysisMode::DUPLICATE_FINDER;
+				  m_fingerprintIndex.val = args.getValueForOption("--dupes").trim();
+				  if (m_fingerprintIndex.val.isEmpty())
+				  {
+					  m_fingerprintIndex.val = "zerochecker.zfp";
+				  }
+			  }});
+	addCommand(m_fingerprintIndex.cmd);
+
+	// Threshold sweep mode
+	m_sweepMinimums.cmd = juce::ConsoleApplication::Command(
+			{ "--sweep", "--sweep=<0.001,0.003,0.01,0.03>",
+			  "Zerocheck every file with each of several minimum amplitudes in a single pass.",
+			  "Overrides zerochecking to list first and last non-zeroes for every minimum and --sweep-consec count, decoding each block only once.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_analysisMode = AnalysisMode::THRESHOLD_SWEEP;
+				  auto values{ juce::StringArray::fromTokens(args.getValueForOption("--sweep"), ",", "") };
+				  values.removeEmptyStrings();
+				  for (const auto& value : values.isEmpty() ? juce::StringArray{ "0.001", "0.003", "0.01", "0.03" } : values)
+				  {
+					  m_sweepMinimums.val.push_back(std::clamp(value.trim().getDoubleValue(), 0.0, 1.0));
+				  }
+				  std::sort(m_sweepMinimums.val.begin(), m_sweepMinimums.val.end());
+				  m_sweepMinimums.val.erase(std::unique(m_sweepMinimums.val.begin(), m_sweepMinimums.val.end()),
+				                            m_sweepMinimums.val.end());
+			  }});
+	addCommand(m_sweepMinimums.cmd);
+
+	// Consecutive sample counts for --sweep
+	m_sweepConsecutiveSamples.cmd = juce::ConsoleApplication::Command(
+			{ "--sweep-consec", "--sweep-consec=<0,16,64>",
+			  "Consecutive sample counts to combine with every --sweep minimum (default: -s|--consec).",
+			  "Each minimum is paired with each count, so 4 minimums and 3 counts give 12 results per file.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  auto values{ juce::StringArray::fromTokens(args.getValueForOption("--sweep-consec"), ",", "") };
+				  values.removeEmptyStrings();
+				  for (const auto& value : values.isEmpty() ? juce::StringArray{ "0", "16", "64" } : values)
+				  {
+					  m_sweepConsecutiveSamples.val.push_back(std::max(value.trim().getIntValue(), 0));
+				  }
+				  std::sort(m_sweepConsecutiveSamples.val.begin(), m_sweepConsecutiveSamples.val.end());
+				  m_sweepConsecutiveSamples.val.erase(std::unique(m_sweepConsecutiveSamples.val.begin(),
+				                                                  m_sweepConsecutiveSamples.val.end()),
+				                                      m_sweepConsecutiveSamples.val.end());
+			  }});
+	addCommand(m_sweepConsecutiveSamples.cmd);
+
+	// EBU R128 loudness mode
+	m_loudnessTarget.cmd = juce::ConsoleApplication::Command(
+			{ "--loudness", "--loudness=<-23>",
+			  "EBU R128 loudness. Target integrated loudness (LUFS) that every file is compared against.",
+			  "Overrides zerochecking to measure integrated loudness, loudness range and true peak in one pass, counting files more than 1 LU off target or above -1 dBTP.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_analysisMode = AnalysisMode::LOUDNESS_CHECKER;
+				  const auto value{ args.getValueForOption("--loudness").trim() };
+				  m_loudnessTarget.val = value.isEmpty() ? -23.0 : std::clamp(value.getDoubleValue(), -70.0, 0.0);
+			  }});
+	addCommand(m_loudnessTarget.cmd);
+
+	// Peak pyramid sidecars
+	m_pyramidDirectory.cmd = juce::ConsoleApplication::Command(
+			{ "--pyramid", "--pyramid=<cache folder>",
+			  "Store a min/max peak pyramid per file (next to each file if no folder is given) and reuse it for zerochecking.",
+			  "Pyramids don't depend on --min/--max/--offset/--consec, so re-running with new thresholds only decodes the few blocks that decide the answer.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_pyramidDirectory.val = args.getValueForOption("--pyramid").trim();
+			  }});
+	addCommand(m_pyramidDirectory.cmd);
+
+	// Watch folders for new exports
+	m_watchSettleMilliseconds.cmd = juce::ConsoleApplication::Command(
+			{ "--watch", "--watch=<2000>",
+			  "Keep running and analyze new or modified files in the given folders, once untouched for N milliseconds.",
+			  "Results are printed and appended to the CSV after every batch, so problems show up seconds after export.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto value{ args.getValueForOption("--watch").trim() };
+				  m_watchSettleMilliseconds.val = value.isEmpty() ? 2000 : std::max(value.getIntValue(), 0);
+			  }});
+	addCommand(m_watchSettleMilliseconds.cmd);
+
+	// Socket server with a warm worker pool
+	m_serveSocket.cmd = juce::ConsoleApplication::Command(
+			{ "--serve", "--serve=<socket path>",
+			  "Keep running and answer JSON requests on a Unix domain socket (zerochecker.sock in the temp folder by default).",
+			  "Formats, readers and worker threads stay warm between requests, so build tools checking a few files at a time skip process startup.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  m_serveSocket.val = args.getValueForOption("--serve").trim();
+			  }});
+	addCommand(m_serveSocket.cmd);
+
+	// Thin client for --serve, handled in main() before a Checker is built and listed here for the help text
+	addCommand({ "--client", "--client=<socket path>",
+	             "Send the given files and options to a running --serve instance and print its JSON results.",
+	             "Supports zerochecker, monochecker and --analyze with --offset, --num, --min, --max and --consec.",
+	             [](const juce::ArgumentList&) { } });
+
+	// Deterministic partition of the discovered files
+	m_shard.cmd = juce::ConsoleApplication::Command(
+			{ "--shard", "--shard=<1/4>",
+			  "Only analyze shard i of n, split by a stable hash of each file's path relative to its input folder.",
+			  "Run every shard on its own machine with the same inputs and an .ndjson output, then combine them with --merge.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto value{ args.getValueForOption("--shard").trim() };
+				  const auto index{ value.upToFirstOccurrenceOf("/", false, false).getIntValue() };
+				  const auto count{ value.fromFirstOccurrenceOf("/", false, false).getIntValue() };
+				  if (count < 1 || index < 1 || index > count)
+				  {
+					  juce::ConsoleApplication::fail("Invalid --shard, expected i/n with 1 <= i <= n: " + value);
+				  }
+				  m_shard.val = std::pair{ index - 1, count };
+			  }});
+	addCommand(m_shard.cmd);
+
+	// Combine shard outputs
+	m_merge.cmd = juce::ConsoleApplication::Command(
+			{ "--merge", "--merge <outputs>",
+			  "Combine .ndjson or .csv outputs from --shard runs into one report, optionally written with -c|--csv.",
+			  "Stats are summed from the records at the end of each .ndjson output; .csv outputs only contribute rows.",
+			  [this](const juce::ArgumentList&)
+			  {
+				  m_merge.val = true;
+			  }});
+	addCommand(m_merge.cmd);
+
+	// Cap memory held by concurrent large-file tasks
+	m_maxMemoryBytes.cmd = juce::ConsoleApplication::Command(
+			{ "--max-memory", "--max-memory=<2048>",
+			  "Limit the buffers held by concurrent large-file tasks to N megabytes.",
+			  "Files over 64 MB wait for room in the budget before they start, while smaller files keep running on every core.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto value{ args.getValueForOption("--max-memory").trim() };
+				  const auto megabytes{ value.getLargeIntValue() };
+				  if (!value.containsOnly("0123456789") || megabytes <= 0)
+				  {
+					  juce::ConsoleApplication::fail("Invalid --max-memory, expected a size in megabytes: " + value);
+				  }
+				  m_maxMemoryBytes.val = megabytes * 1024 * 1024;
+				  m_memoryBudget = std::make_unique<MemoryBudget>(*m_maxMemoryBytes.val);
+			  }});
+	addCommand(m_maxMemoryBytes.cmd);
+
 	// Parse optional csv
 	m_csv.cmd = juce::ConsoleApplication::Command(
-			{ "-c|--csv", "-c|--csv <output.csv>", "Specify output .csv filepath",
-			  "Generates CSV file from zerochecker output.",
+			{ "-c|--csv", "-c|--csv <output.csv>", "Specify output .csv (or .ndjson) filepath",
+			  "Generates CSV file from zerochecker output, or one JSON object per row plus a stats record for .ndjson/.jsonl.",
 			  [this](const juce::ArgumentList& args)
 			  {
 				  m_csv.val = args.getValueForOption("-c|--csv");
@@ -112,7 +423,7 @@ Checker::Checker()
 			  "Relative offset from start and end of file before analysis of level.",
 			  [this](const juce::ArgumentList& args)
 			  {
-				  m_sampleOffset.val = args.getValueForOption("-o|--offset").getIntValue();
+				  m_sampleOffset.val = args.getValueForOption("-o|--offset").getLargeIntValue();
 			  }});
 	addCommand(m_sampleOffset.cmd);
 
@@ -122,7 +433,7 @@ Checker::Checker()
 			  "Restricts the number of samples analyzed before stopping.",
 			  [this](const juce::ArgumentList& args)
 			  {
-				  m_numSamplesToSearch.val = args.getValueForOption("-n|--num").getIntValue();
+				  m_numSamplesToSearch.val = args.getValueForOption("-n|--num").getLargeIntValue();
 			  }});
 	addCommand(m_numSamplesToSearch.cmd);
 
@@ -158,6 +469,18 @@ Checker::Checker()
 			  }});
 	addCommand(m_magnitudeRangeMin.cmd);
 
+	// Per-stage timing instrumentation
+	m_profile.cmd = juce::ConsoleApplication::Command(
+			{ "-p|--profile", "-p|--profile <10>", "Print per-stage timings and the N slowest files",
+			  "Records per-thread timers for discovery, reader creation, decoding, analysis, output and processing.",
+			  [this](const juce::ArgumentList& args)
+			  {
+				  const auto value{ args.getValueForOption("-p|--profile") };
+				  m_profile.val = value.isEmpty() ? s_defaultProfileFiles : std::max(value.getIntValue(), 0);
+				  Profiler::get().enable(*m_profile.val);
+			  }});
+	addCommand(m_profile.cmd);
+
 	// Help & version
 	addHelpCommand("-h|--help", juce::String("ABOUT:\n    zerochecker v") + ProjectInfo::versionString +
 	                            ltrl::helpText, true);
@@ -178,8 +501,13 @@ int Checker::run(const juce::ArgumentList& args)
 	{
 		if (arg.isOption())
 		{
-			findAndRunCommand(juce::ArgumentList(args.executableName,
-			                                     juce::StringArray(arg.text, args.getValueForOption(arg.text))));
+			// Options that fail to parse have already printed why, so stop before scanning anything
+			if (const auto result{ findAndRunCommand(juce::ArgumentList(
+			        args.executableName, juce::StringArray(arg.text, args.getValueForOption(arg.text)))) };
+			    result != 0)
+			{
+				return result;
+			}
 		}
 		else if (!arg.isOption() && !arg.text.containsIgnoreCase("csv"))
 		{
@@ -187,8 +515,29 @@ int Checker::run(const juce::ArgumentList& args)
 		}
 	}
 
+	// Shard outputs are the inputs here, so skip discovery entirely
+	if (m_merge.val)
+	{
+		return invokeCatchingFailures([&] { return mergeResults(args); });
+	}
+
+	// Serve requests instead of scanning here
+	if (m_serveSocket.val.has_value())
+	{
+		return invokeCatchingFailures([&] { return serve(); });
+	}
+
+	// Watch folders instead of scanning them once
+	if (m_watchSettleMilliseconds.val.has_value())
+	{
+		return invokeCatchingFailures([&] { return watchFolders(juce::ArgumentList(args.executableName, filelist)); });
+	}
+
 	// Fetch input files
-	m_files.cmd.command(juce::ArgumentList(args.executableName, filelist));
+	{
+		Profiler::ScopedStage stage{ Profiler::Stage::DISCOVERY };
+		m_files.cmd.command(juce::ArgumentList(args.executableName, filelist));
+	}
 
 	// Run zerochecker
 	if (!m_files.val.empty())
@@ -207,6 +556,7 @@ void Checker::updateProgress(std::mutex& m) const
 
 void Checker::appendFile(std::mutex& m, const File& zeroFile) const
 {
+	Profiler::ScopedStage stage{ Profiler::Stage::OUTPUT };
 	std::lock_guard<std::mutex> guard(m);
 	m_console->append(zeroFile);
 }
@@ -216,14 +566,214 @@ void Checker::scanFiles()
 	m_console = std::make_unique<Console>(*this, m_csv.val, static_cast<int>(m_files.val.size()));
 	jassert(m_console);
 
+	analyzeFiles();
+	m_console->print();
+}
+
+int Checker::watchFolders(const juce::ArgumentList& args)
+{
+	if (m_analysisMode == AnalysisMode::ALIGNMENT_CHECKER)
+	{
+		juce::ConsoleApplication::fail("--watch can't be combined with --align, which needs whole groups at once");
+	}
+
+	juce::Array<juce::File> folders{};
+	for (const auto& arg : args.arguments)
+	{
+		if (const auto folder{ arg.resolveAsFile() }; folder.isDirectory())
+		{
+			folders.add(folder);
+		}
+	}
+
+	Watcher watcher{ folders, ltrl::audioFileExtensions, *m_watchSettleMilliseconds.val };
+	if (!watcher.isWatching())
+	{
+		juce::ConsoleApplication::fail("--watch needs at least one folder to watch");
+	}
+
+	// One console for the whole session; each batch is printed and appended to the CSV as soon as it's analyzed
+	m_console = std::make_unique<Console>(*this, m_csv.val);
+	std::cout << "Watching " << folders.size() << " folder(s) for new or modified files. Press Ctrl+C to stop."
+	          << ltrl::endl << std::flush;
+
+	while (watcher.isWatching())
+	{
+		const auto files{ watcher.waitForFiles(s_watchPollMilliseconds) };
+		if (files.empty())
+		{
+			continue;
+		}
+
+		m_files.val.clear();
+		for (const auto& file : files)
+		{
+			m_files.val.emplace_back(file);
+		}
+		analyzeFiles();
+		m_console->printRows();
+	}
+	return 0;
+}
+
+int Checker::mergeResults(const juce::ArgumentList& args)
+{
+	// Resolved as Console will write it, so a previous merged output is never read back in as a shard
+	const auto output{ (m_csv.val.has_value() && m_csv.val->isNotEmpty()) ? Console::getOutputFile(*m_csv.val) :
+	                   juce::File() };
+	std::vector<std::string> header{};
+	std::vector<std::pair<juce::String, std::vector<std::string>>> rows{};
+	std::vector<juce::var> stats{};
+	auto numItems{ 0 };
+
+	for (const auto& arg : args.arguments)
+	{
+		const auto input{ arg.resolveAsFile() };
+		if (arg.isOption() || input == output || !input.existsAsFile() || !input.hasFileExtension("csv;ndjson;jsonl"))
+		{
+			continue;
+		}
+
+		if (input.hasFileExtension("csv"))
+		{
+			// Every field is followed by a separator, as written by Console
+			const auto csvRows{ Console::parseCsv(input.loadFileAsString().toStdString()) };
+			for (size_t line{ 0 }; line < csvRows.size(); ++line)
+			{
+				auto columns{ csvRows[line] };
+				if (columns.back().empty())
+				{
+					columns.pop_back();
+				}
+				if (columns.empty())
+				{
+					continue;
+				}
+				const juce::String fullPath{ columns.front() };
+				columns.erase(columns.begin());
+
+				if (line == 0)
+				{
+					if (!header.empty() && columns != header)
+					{
+						juce::ConsoleApplication::fail(input.getFullPathName() + " has different columns than earlier outputs");
+					}
+					header = columns;
+					continue;
+				}
+				rows.emplace_back(fullPath, columns);
+				++numItems;
+			}
+			continue;
+		}
+
+		juce::StringArray lines{};
+		lines.addLines(input.loadFileAsString());
+		lines.removeEmptyStrings();
+
+		for (const auto& line : lines)
+		{
+			const auto json{ juce::JSON::parse(line) };
+			if (auto* obj = json.getDynamicObject())
+			{
+				if (obj->hasProperty("stats"))
+				{
+					stats.push_back(obj->getProperty("stats"));
+					continue;
+				}
+
+				// Keys are written in column order, after the full path
+				std::vector<std::string> columns{};
+				std::vector<std::string> keys{};
+				for (const auto& property : obj->getProperties())
+				{
+					if (property.name.toString() != ltrl::fullPathHeader)
+					{
+						keys.push_back(property.name.toString().toStdString());
+						columns.push_back(property.valuePtr->toString().toStdString());
+					}
+				}
+
+				if (!header.empty() && keys != header)
+				{
+					juce::ConsoleApplication::fail(input.getFullPathName() + " has different columns than earlier outputs");
+				}
+				header = keys;
+				rows.emplace_back(obj->getProperty(ltrl::fullPathHeader).toString(), columns);
+			}
+		}
+	}
+
+	if (header.empty())
+	{
+		juce::ConsoleApplication::fail("--merge found no rows in the given outputs");
+	}
+
+	// Mode and options come from the first shard, so the report matches a single-machine run
+	for (const auto& stat : stats)
+	{
+		if (static_cast<int>(stat["mode"]) != static_cast<int>(stats.front()["mode"]))
+		{
+			juce::ConsoleApplication::fail("--merge outputs come from different analysis modes");
+		}
+		numItems += static_cast<int>(stat["files"]);
+	}
+	if (!stats.empty())
+	{
+		m_analysisMode = static_cast<AnalysisMode>(static_cast<int>(stats.front()["mode"]));
+		m_analyses.val = static_cast<int>(stats.front()["analyses"]);
+		m_loudnessTarget.val = static_cast<double>(stats.front().getProperty("loudnessTarget", m_loudnessTarget.val));
+		if (static_cast<bool>(stats.front()["pyramid"]))
+		{
+			m_pyramidDirectory.val = juce::String();
+		}
+	}
+
+	m_console = std::make_unique<Console>(*this, m_csv.val, numItems);
+	m_console->setHeader(header);
+	for (const auto& [fullPath, columns] : rows)
+	{
+		m_console->append(columns, fullPath);
+	}
+	for (const auto& stat : stats)
+	{
+		m_console->addStats(stat);
+	}
+	m_console->print();
+	return 0;
+}
+
+int Checker::serve()
+{
+	const auto socket{ m_serveSocket.val->isEmpty() ? Server::getDefaultSocket() :
+	                   juce::File::getCurrentWorkingDirectory().getChildFile(*m_serveSocket.val) };
+	Server server{ socket, ltrl::audioFileExtensions };
+	if (!server.listen())
+	{
+		juce::ConsoleApplication::fail("Unable to listen on " + socket.getFullPathName() +
+		                               ", or another zerochecker server is already running there");
+	}
+
+	std::cout << "Serving on " << socket.getFullPathName() << ". Press Ctrl+C to stop." << ltrl::endl << std::flush;
+	server.run();
+	juce::ConsoleApplication::fail("Stopped accepting connections on " + socket.getFullPathName());
+	return 1;
+}
+
+void Checker::analyzeFiles()
+{
+	jassert(m_console);
+
 	std::mutex m;
 
 	auto monoAnalyze = [&](File& zeroFile)
 	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
 		updateProgress(m);
-		if (auto reader = std::unique_ptr<juce::AudioFormatReader>(m_formatMngr.createReaderFor(zeroFile.m_file)))
+		if (auto reader = createReader(zeroFile.m_file))
 		{
-			zeroFile.calculateMonoCompatibility(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val);
+			zeroFile.calculateMonoCompatibility(reader.get(), [&] { return createReader(zeroFile.m_file); },
+			                                    m_sampleOffset.val, m_numSamplesToSearch.val);
 
 			// Only append files above threshold
 			if (zeroFile.m_monoCompatibility > m_monoAnalysisThreshold.val)
@@ -235,20 +785,217 @@ void Checker::scanFiles()
 
 	auto zeroCheck = [&](File& zeroFile)
 	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
 		updateProgress(m);
-		if (auto reader = std::unique_ptr<juce::AudioFormatReader>(m_formatMngr.createReaderFor(zeroFile.m_file)))
+
+		// Indexed once here and shared by every chunk reader, since building it scans the tail of the file
+		const auto flacIndex{ indexFlac(zeroFile.m_file) };
+		auto reader{ createReader(zeroFile.m_file, flacIndex.get()) };
+		if (reader == nullptr)
 		{
-			zeroFile.calculate(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, m_magnitudeRangeMin.val,
+			return;
+		}
+
+		if (m_pyramidDirectory.val.has_value())
+		{
+			// Build the sidecar with one full decode pass if it is missing or stale
+			PeakPyramid pyramid{};
+			const auto sidecar{ PeakPyramid::getSidecarFile(zeroFile.m_file, *m_pyramidDirectory.val) };
+			if (pyramid.load(sidecar, zeroFile.m_file, reader->lengthInSamples))
+			{
+				++m_numReusedPyramids;
+			}
+			else
+			{
+				std::vector<std::unique_ptr<Analyzer>> analyzers{};
+				analyzers.emplace_back(std::make_unique<PyramidAnalyzer>(pyramid));
+				zeroFile.analyze(reader.get(), 0, -1, analyzers);
+				pyramid.save(sidecar, zeroFile.m_file);
+			}
+
+			zeroFile.calculate(reader.get(), pyramid, m_sampleOffset.val, m_numSamplesToSearch.val,
+			                   m_magnitudeRangeMin.val, m_magnitudeRangeMax.val, m_minConsecutiveSamples.val);
+		}
+		else
+		{
+			// Long recordings are split into chunks scanned on all cores, each with its own reader
+			zeroFile.calculate(reader.get(), [&] { return createReader(zeroFile.m_file, flacIndex.get()); },
+			                   m_sampleOffset.val, m_numSamplesToSearch.val, m_magnitudeRangeMin.val,
 			                   m_magnitudeRangeMax.val, m_minConsecutiveSamples.val);
+		}
+		appendFile(m, zeroFile);
+	};
+
+	auto multiAnalyze = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (auto reader = createReader(zeroFile.m_file))
+		{
+			std::vector<std::unique_ptr<Analyzer>> analyzers{};
+			if (hasAnalysis(Analysis::ZERO))
+			{
+				analyzers.emplace_back(std::make_unique<ZeroAnalyzer>(m_magnitudeRangeMin.val, m_magnitudeRangeMax.val,
+				                                                      m_minConsecutiveSamples.val));
+			}
+			if (hasAnalysis(Analysis::MONO))
+			{
+				analyzers.emplace_back(std::make_unique<MonoAnalyzer>());
+			}
+			if (hasAnalysis(Analysis::LEVEL))
+			{
+				analyzers.emplace_back(std::make_unique<LevelAnalyzer>());
+			}
+
+			zeroFile.analyze(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, analyzers);
+			appendFile(m, zeroFile);
+		}
+	};
+
+	auto loopCheck = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (auto reader = createReader(zeroFile.m_file))
+		{
+			zeroFile.calculateLoopClickRisk(reader.get(), m_loopWindowSize.val);
+			appendFile(m, zeroFile);
+		}
+	};
+
+	auto segment = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (auto reader = createReader(zeroFile.m_file))
+		{
+			std::vector<std::unique_ptr<Analyzer>> analyzers{};
+			analyzers.emplace_back(std::make_unique<SegmentAnalyzer>(m_magnitudeRangeMin.val, m_magnitudeRangeMax.val,
+			                                                         m_minConsecutiveSamples.val,
+			                                                         m_minGapMilliseconds.val / 1000.0));
+			zeroFile.analyze(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, analyzers);
+			appendFile(m, zeroFile);
+		}
+	};
+
+	auto alignGroup = [&](const juce::String& key, std::vector<File*>& group)
+	{
+		std::sort(group.begin(), group.end(), [](const File* a, const File* b)
+		{
+			return a->m_file.getFileName() < b->m_file.getFileName();
+		});
+
+		// Shared onset across the group, so every window starts at the same position on a common timeline
+		std::vector<std::unique_ptr<juce::AudioFormatReader>> readers{};
+		juce::int64 onset{ -1 };
+		for (auto* zeroFile : group)
+		{
+			Profiler::ScopedFile profileFile{ zeroFile->m_file };
+			updateProgress(m);
+			zeroFile->m_alignmentGroup = juce::File(key).getFileName();
+			readers.emplace_back(createReader(zeroFile->m_file, indexFlac(zeroFile->m_file).get()));
+			if (auto& reader = readers.back())
+			{
+				zeroFile->calculate(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, m_magnitudeRangeMin.val,
+				                    m_magnitudeRangeMax.val, m_minConsecutiveSamples.val);
+				if (zeroFile->m_firstNonZeroSample >= 0 && (onset < 0 || zeroFile->m_firstNonZeroSample < onset))
+				{
+					onset = zeroFile->m_firstNonZeroSample;
+				}
+			}
+		}
+
+		const auto& reference{ readers.front() };
+		if (onset >= 0 && reference != nullptr)
+		{
+			// Leave a quarter window of pre-roll, so files that start before the reference are still caught
+			const auto windowStart{ std::max(onset - s_alignmentWindowSize / 4, static_cast<juce::int64>(0)) };
+			const auto referenceWindow{ readOnsetWindow(*reference, windowStart, s_alignmentWindowSize) };
+			group.front()->m_alignmentCorrelation = (group.size() > 1) ? 1.0f : -1.0f;
+
+			for (size_t index{ 1 }; index < group.size(); ++index)
+			{
+				const auto& reader{ readers[index] };
+				if (reader == nullptr || reader->sampleRate != reference->sampleRate)
+				{
+					continue;
+				}
+
+				Profiler::ScopedFile profileFile{ group[index]->m_file };
+				const auto alignment{ crossCorrelate(referenceWindow,
+				                                     readOnsetWindow(*reader, windowStart, s_alignmentWindowSize)) };
+				group[index]->m_alignmentOffset = alignment.m_offset;
+				group[index]->m_alignmentOffsetTime = juce::RelativeTime(static_cast<double>(alignment.m_offset) /
+				                                                         reader->sampleRate);
+				group[index]->m_alignmentCorrelation = alignment.m_correlation;
+			}
+		}
+
+		for (size_t index{ 0 }; index < group.size(); ++index)
+		{
+			group[index]->m_alignmentReference = group.front()->m_file.getFileName();
+			if (readers[index] != nullptr)
+			{
+				appendFile(m, *group[index]);
+			}
+		}
+	};
+
+	auto sweep = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (auto reader = createReader(zeroFile.m_file))
+		{
+			zeroFile.calculateSweep(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, m_sweepMinimums.val,
+			                        m_magnitudeRangeMax.val, getSweepConsecutiveSamples());
 			appendFile(m, zeroFile);
 		}
 	};
 
+	auto measureLoudness = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (auto reader = createReader(zeroFile.m_file))
+		{
+			std::vector<std::unique_ptr<Analyzer>> analyzers{};
+			analyzers.emplace_back(std::make_unique<LoudnessAnalyzer>());
+			zeroFile.analyze(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, analyzers);
+			appendFile(m, zeroFile);
+		}
+	};
+
+	auto fingerprint = [&](const FingerprintIndex& index, File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (const auto* signature = index.find(zeroFile.m_file))
+		{
+			zeroFile.m_fingerprint = *signature;
+			++m_numReusedFingerprints;
+		}
+		else if (auto reader = createReader(zeroFile.m_file))
+		{
+			std::vector<std::unique_ptr<Analyzer>> analyzers{};
+			analyzers.emplace_back(std::make_unique<FingerprintAnalyzer>());
+			zeroFile.analyze(reader.get(), m_sampleOffset.val, m_numSamplesToSearch.val, analyzers);
+		}
+	};
+
 	switch (m_analysisMode)
 	{
 	case AnalysisMode::ZERO_CHECKER:
 	{
-		for_each(zeroCheck);
+		// Pyramids are built with a full decode pass, so only plain searches benefit from head/tail prefetching
+		if (m_pyramidDirectory.val.has_value())
+		{
+			for_each(zeroCheck);
+		}
+		else
+		{
+			for_each_prefetched(zeroCheck);
+		}
 		break;
 	}
 	case AnalysisMode::MONO_COMPATIBILITY_CHECKER:
@@ -256,9 +1003,73 @@ void Checker::scanFiles()
 		for_each(monoAnalyze);
 		break;
 	}
+	case AnalysisMode::MULTI_ANALYSIS:
+	{
+		for_each(multiAnalyze);
+		break;
+	}
+	case AnalysisMode::LOOP_CHECKER:
+	{
+		for_each(loopCheck);
+		break;
 	}
+	case AnalysisMode::GAP_SEGMENTER:
+	{
+		for_each(segment);
+		break;
+	}
+	case AnalysisMode::THRESHOLD_SWEEP:
+	{
+		for_each(sweep);
+		break;
+	}
+	case AnalysisMode::LOUDNESS_CHECKER:
+	{
+		for_each(measureLoudness);
+		break;
+	}
+	case AnalysisMode::ALIGNMENT_CHECKER:
+	{
+		auto groups{ groupFiles(m_files.val, m_alignPattern.val) };
+		m_numAlignmentGroups = static_cast<int>(groups.size());
+#if defined (JUCE_MAC)
+		std::for_each(groups.begin(), groups.end(), [&](auto& group) { alignGroup(group.first, group.second); });
+#else
+		std::for_each(std::execution::par, groups.begin(), groups.end(),
+		              [&](auto& group) { alignGroup(group.first, group.second); });
+#endif
+		break;
+	}
+	case AnalysisMode::DUPLICATE_FINDER:
+	{
+		FingerprintIndex index{ juce::File::getCurrentWorkingDirectory().getChildFile(m_fingerprintIndex.val),
+		                        m_sampleOffset.val, m_numSamplesToSearch.val };
+		index.load();
+		for_each([&](File& zeroFile) { fingerprint(index, zeroFile); });
 
-	m_console->print();
+		// Index covers the whole library, so matches may also be files outside of this scan
+		for (const auto& zeroFile : m_files.val)
+		{
+			index.update(zeroFile.m_file, zeroFile.m_fingerprint);
+		}
+		index.prune();
+		index.save();
+
+		const auto duplicates{ index.findDuplicates(s_minDuplicateSimilarity) };
+		for (auto& zeroFile : m_files.val)
+		{
+			if (const auto it{ duplicates.find(zeroFile.m_file.getFullPathName()) }; it != duplicates.end())
+			{
+				zeroFile.m_duplicateOf = it->second.m_closestMatch;
+				zeroFile.m_duplicateOriginal = it->second.m_original;
+				zeroFile.m_duplicateSimilarity = it->second.m_similarity;
+				zeroFile.m_numDuplicates = it->second.m_numDuplicates;
+			}
+			appendFile(m, zeroFile);
+		}
+		break;
+	}
+	}
 }
 
 void Checker::processFiles()
@@ -269,69 +1080,73 @@ void Checker::processFiles()
 
 	auto trimToZeroes = [&](File& zeroFile)
 	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
 		updateProgress(m);
 		if (zeroFile.m_firstNonZeroSample < 0 || zeroFile.m_lastNonZeroSample < 0)
 		{
 			return;
 		}
-		auto reader{ std::unique_ptr<juce::AudioFormatReader>(m_formatMngr.createReaderFor(zeroFile.m_file)) };
+		auto reader{ createReader(zeroFile.m_file) };
 		if (reader == nullptr)
 		{
 			return;
 		}
+		Profiler::ScopedStage stage{ Profiler::Stage::PROCESS };
 
+		// Keep the middle, trimmed section of file
 		const auto numChannels{ static_cast<int>(reader->numChannels) };
-		const auto startSampleRead{ static_cast<int>(zeroFile.m_firstNonZeroSample) };
-		const auto startSampleWrite{ 0 };
-		const auto endSample{ static_cast<int>(reader->lengthInSamples - zeroFile.m_lastNonZeroSample) };
-		const auto numSamples{ endSample - startSampleRead };
-
-		// Save middle, trimmed section of file to buffer
-		juce::AudioBuffer<float> buffer{ numChannels, numSamples };
-		reader->read(&buffer, startSampleWrite, numSamples, startSampleRead, true, true);
-
-		juce::FileOutputStream fileStream(zeroFile.m_file);
-		if (fileStream.failedToOpen())
+		const juce::Range<juce::int64> range{ zeroFile.m_firstNonZeroSample,
+		                                      reader->lengthInSamples - zeroFile.m_lastNonZeroSample };
+		if (!range.isEmpty())
 		{
-			return;
-		}
-		eraseFileContents(fileStream);
-		if (auto writer = getWavFlacWriter(zeroFile.m_file, *reader, numChannels))
-		{
-			writer->writeFromAudioSampleBuffer(buffer, startSampleWrite, numSamples);
+			rewriteRange(std::move(reader), zeroFile.m_file, range, numChannels);
 		}
 	};
 
 	auto convertToMono = [&](File& zeroFile)
 	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
 		updateProgress(m);
 		if (zeroFile.m_monoCompatibility <= m_monoAnalysisThreshold.val)
 		{
 			return;
 		}
-		auto reader{ std::unique_ptr<juce::AudioFormatReader>(m_formatMngr.createReaderFor(zeroFile.m_file)) };
+		auto reader{ createReader(zeroFile.m_file) };
 		if (reader == nullptr)
 		{
 			return;
 		}
+		Profiler::ScopedStage stage{ Profiler::Stage::PROCESS };
 
-		const auto numChannels{ 1 };
-		const auto numSamples{ static_cast<int>(reader->lengthInSamples) };
-		const auto startSample{ 0 };
-
-		// Save first channel to buffer
-		juce::AudioBuffer<float> buffer{ numChannels, static_cast<int>(numSamples) };
-		reader->read(&buffer, startSample, numSamples, startSample, true, false);
+		// Keep first channel only
+		const juce::Range<juce::int64> range{ 0, reader->lengthInSamples };
+		rewriteRange(std::move(reader), zeroFile.m_file, range, 1);
+	};
 
-		juce::FileOutputStream fileStream(zeroFile.m_file);
-		if (fileStream.failedToOpen())
+	auto splitAtGaps = [&](File& zeroFile)
+	{
+		Profiler::ScopedFile profileFile{ zeroFile.m_file };
+		updateProgress(m);
+		if (zeroFile.m_regions.size() < 2)
 		{
 			return;
 		}
-		eraseFileContents(fileStream);
-		if (auto writer = getWavFlacWriter(zeroFile.m_file, *reader, numChannels))
+		auto reader{ createReader(zeroFile.m_file) };
+		if (reader == nullptr)
 		{
-			writer->writeFromAudioSampleBuffer(buffer, startSample, numSamples);
+			return;
+		}
+		Profiler::ScopedStage stage{ Profiler::Stage::PROCESS };
+
+		// Each region is copied block by block into its own numbered sibling file
+		const auto numChannels{ static_cast<int>(reader->numChannels) };
+		for (size_t region{ 0 }; region < zeroFile.m_regions.size(); ++region)
+		{
+			const auto regionFile{ zeroFile.m_file.getSiblingFile(
+					zeroFile.m_file.getFileNameWithoutExtension() + "_" + juce::String(region + 1).paddedLeft('0', 2) +
+					zeroFile.m_file.getFileExtension()) };
+			regionFile.deleteFile();
+			writeRange(*reader, regionFile, zeroFile.m_regions[region], numChannels);
 		}
 	};
 
@@ -349,14 +1164,219 @@ void Checker::processFiles()
 		for_each(convertToMono);
 		break;
 	}
+	case AnalysisMode::GAP_SEGMENTER:
+	{
+		m_console->progressBar(m_numSegmentedFiles);
+		for_each(splitAtGaps);
+		break;
+	}
+	case AnalysisMode::MULTI_ANALYSIS:
+	case AnalysisMode::LOOP_CHECKER:
+	case AnalysisMode::ALIGNMENT_CHECKER:
+	case AnalysisMode::DUPLICATE_FINDER:
+	case AnalysisMode::THRESHOLD_SWEEP:
+	case AnalysisMode::LOUDNESS_CHECKER:
+	{
+		// Report-only modes; run a single zerochecker or monochecker pass to process files
+		break;
+	}
 	}
 }
 
 void Checker::for_each(std::function<void(zero::File&)> function)
+{
+	for_each(m_files.val.begin(), m_files.val.end(), std::move(function));
+}
+
+void Checker::for_each(std::vector<File>::iterator first, std::vector<File>::iterator last,
+                       std::function<void(zero::File&)> function)
 {
 #if defined (JUCE_MAC)
-	std::for_each(m_files.val.begin(), m_files.val.end(), function);
+	std::for_each(first, last, function);
 #else
-	std::for_each(std::execution::par_unseq, m_files.val.begin(), m_files.val.end(), function);
+	// Tasks take locks for progress and output, so they need par rather than par_unseq
+	if (m_memoryBudget == nullptr)
+	{
+		std::for_each(std::execution::par, first, last, function);
+		return;
+	}
+
+	std::vector<File*> smallFiles{};
+	std::vector<File*> largeFiles{};
+	for (auto it{ first }; it != last; ++it)
+	{
+		(it->m_file.getSize() < MemoryBudget::s_largeFileBytes ? smallFiles : largeFiles).push_back(&*it);
+	}
+
+	// Large files are admitted on this scheduler rather than blocking inside tasks the parallel algorithm may have
+	// stolen; the semaphore caps how many run at once and the budget caps the memory they hold
+	auto scheduler{ std::async(std::launch::async, [&]
+	{
+		std::counting_semaphore<> slots{ juce::SystemStats::getNumCpus() };
+		std::vector<std::future<void>> running{};
+		for (auto* zeroFile : largeFiles)
+		{
+			slots.acquire();
+			auto task = [&, zeroFile, reservation = reserveMemory(*zeroFile)]() mutable
+			{
+				// Released as soon as the file is done rather than when its future goes away
+				const auto admitted{ std::move(reservation) };
+				function(*zeroFile);
+				slots.release();
+			};
+			running.push_back(std::async(std::launch::async, std::move(task)));
+		}
+		for (auto& task : running)
+		{
+			task.get();
+		}
+	}) };
+
+	std::for_each(std::execution::par, smallFiles.begin(), smallFiles.end(), [&](File* zeroFile) { function(*zeroFile); });
+	scheduler.get();
 #endif
 }
+
+void Checker::for_each_prefetched(std::function<void(zero::File&)> function)
+{
+	if (m_prefetcher == nullptr)
+	{
+		m_prefetcher = std::make_unique<BlockPrefetcher>();
+	}
+	if (!m_prefetcher->isAvailable())
+	{
+		for_each(std::move(function));
+		return;
+	}
+
+	std::vector<std::vector<juce::File>> batches{};
+	for (size_t index{ 0 }; index < m_files.val.size(); ++index)
+	{
+		if (index % s_prefetchBatchSize == 0)
+		{
+			batches.emplace_back();
+		}
+		batches.back().push_back(m_files.val[index].m_file);
+	}
+
+	// The next batch is read while workers analyze the current one, so the device queue never drains
+	auto prefetched{ std::async(std::launch::async, [this, &batches] { m_prefetcher->prefetch(batches.front()); }) };
+	for (size_t batch{ 0 }; batch < batches.size(); ++batch)
+	{
+		prefetched.get();
+		if (batch + 1 < batches.size())
+		{
+			prefetched = std::async(std::launch::async, [this, &batches, batch]
+			{
+				m_prefetcher->prefetch(batches[batch + 1]);
+			});
+		}
+
+		const auto first{ m_files.val.begin() + static_cast<std::ptrdiff_t>(batch * s_prefetchBatchSize) };
+		for_each(first, first + static_cast<std::ptrdiff_t>(batches[batch].size()), function);
+		m_prefetcher->release(batches[batch]);
+	}
+}
+
+MemoryBudget::Reservation Checker::reserveMemory(const File& zeroFile)
+{
+	if (m_memoryBudget == nullptr)
+	{
+		return {};
+	}
+
+	// Only the header is parsed: no FLAC index is built, and a prefetched head is served from memory
+	if (auto reader = createReader(zeroFile.m_file))
+	{
+		return m_memoryBudget->reserve(MemoryBudget::estimateWorkingSet(*reader));
+	}
+	return {};
+}
+
+bool Checker::isInShard(const juce::String& relativePath) const
+{
+	if (!m_shard.val.has_value())
+	{
+		return true;
+	}
+
+	// FNV-1a over forward-slashed UTF-8, so every machine and platform agrees on the split
+	juce::uint64 hash{ 14695981039346656037ull };
+	for (const auto c : relativePath.replaceCharacter('\\', '/').toStdString())
+	{
+		hash ^= static_cast<juce::uint8>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash % static_cast<juce::uint64>(m_shard.val->second) == static_cast<juce::uint64>(m_shard.val->first);
+}
+
+std::vector<int> Checker::getSweepConsecutiveSamples() const
+{
+	if (m_sweepConsecutiveSamples.val.empty())
+	{
+		return { m_minConsecutiveSamples.val };
+	}
+	return m_sweepConsecutiveSamples.val;
+}
+
+bool Checker::hasAnalysis(Analysis analysis) const
+{
+	return (m_analyses.val & analysis) != 0;
+}
+
+std::unique_ptr<FlacFrameIndex> Checker::indexFlac(const juce::File& file) const
+{
+	// Reverse searches seek backwards through the tail; index FLAC frames there so each seek lands directly
+	const auto searchesTail{ m_analysisMode == AnalysisMode::ZERO_CHECKER ||
+	                         m_analysisMode == AnalysisMode::ALIGNMENT_CHECKER };
+	if (!searchesTail || !file.hasFileExtension("flac"))
+	{
+		return nullptr;
+	}
+
+	auto index{ std::make_unique<FlacFrameIndex>() };
+	const auto numTailSamples{ (m_numSamplesToSearch.val < 0) ? static_cast<juce::int64>(-1) :
+	                           m_sampleOffset.val + m_numSamplesToSearch.val };
+	if (!index->build(file, numTailSamples) || index->hasSeekTable())
+	{
+		return nullptr;
+	}
+	return index;
+}
+
+std::unique_ptr<juce::AudioFormatReader> Checker::createReader(const juce::File& file, const FlacFrameIndex* flacIndex)
+{
+	Profiler::ScopedStage stage{ Profiler::Stage::READER };
+
+	// Head and tail were already read in a batch, so the search only goes to the device for what lies between
+	auto stream{ (m_prefetcher != nullptr) ? m_prefetcher->createStream(file) : nullptr };
+
+	// The synthetic SEEKTABLE is layered over whichever stream serves the audio frames
+	if (flacIndex != nullptr)
+	{
+		if (auto indexedStream = flacIndex->createIndexedStream(std::move(stream)))
+		{
+			juce::FlacAudioFormat format{};
+			if (auto* reader = format.createReaderFor(indexedStream.get(), false))
+			{
+				indexedStream.release();
+				return std::unique_ptr<juce::AudioFormatReader>(reader);
+			}
+		}
+		stream = (m_prefetcher != nullptr) ? m_prefetcher->createStream(file) : nullptr;
+	}
+
+	if (stream != nullptr)
+	{
+		if (auto* format = m_formatMngr.findFormatForFileExtension(file.getFileExtension()))
+		{
+			if (auto* reader = format->createReaderFor(stream.get(), false))
+			{
+				stream.release();
+				return std::unique_ptr<juce::AudioFormatReader>(reader);
+			}
+		}
+	}
+
+	return std::unique_ptr<juce::AudioFormatReader>(m_formatMngr.createReaderFor(file));
+}
\ No newline at end of file
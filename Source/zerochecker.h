@@ -11,15 +11,20 @@
 #pragma once
 
 #include "file.h"
+#include "budget.h"
 #include "command.h"
 #include "console.h"
+#include "prefetch.h"
+#include "profiler.h"
 
 #include <JuceHeader.h>
+#include <atomic>
 #include <optional>
 
 namespace zero
 {
 	class Console;
+	class FlacFrameIndex;
 
 	class Checker : public juce::ConsoleApplication
 	{
@@ -30,15 +35,36 @@ namespace zero
 		void updateProgress(std::mutex& m) const;
 		void appendFile(std::mutex& m, const File& zeroFile) const;
 		void scanFiles();
+		int watchFolders(const juce::ArgumentList& args);
+		int mergeResults(const juce::ArgumentList& args);
+		int serve();
+		void analyzeFiles();
 		void processFiles();
 		void for_each(std::function<void(zero::File&)> function);
+		void for_each(std::vector<File>::iterator first, std::vector<File>::iterator last,
+		              std::function<void(zero::File&)> function);
+		void for_each_prefetched(std::function<void(zero::File&)> function);
+		MemoryBudget::Reservation reserveMemory(const File& zeroFile);
+		std::unique_ptr<FlacFrameIndex> indexFlac(const juce::File& file) const;
+		std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& file,
+		                                                      const FlacFrameIndex* flacIndex = nullptr);
 
 		enum class AnalysisMode
 		{
-			ZERO_CHECKER, MONO_COMPATIBILITY_CHECKER
+			ZERO_CHECKER, MONO_COMPATIBILITY_CHECKER, MULTI_ANALYSIS, LOOP_CHECKER, GAP_SEGMENTER, ALIGNMENT_CHECKER,
+			DUPLICATE_FINDER, THRESHOLD_SWEEP, LOUDNESS_CHECKER
 		};
 		AnalysisMode m_analysisMode{ AnalysisMode::ZERO_CHECKER };
 
+		// Analyses combined into a single decode pass by MULTI_ANALYSIS
+		enum Analysis
+		{
+			ZERO = 1 << 0, MONO = 1 << 1, LEVEL = 1 << 2
+		};
+		bool hasAnalysis(Analysis analysis) const;
+		bool isInShard(const juce::String& relativePath) const;
+		std::vector<int> getSweepConsecutiveSamples() const;
+
 		zero::Command<std::vector<File>> m_files{};
 		zero::Command<std::optional<juce::String>> m_csv{ std::nullopt };
 		zero::Command<juce::int64> m_sampleOffset{ 0 };
@@ -47,12 +73,36 @@ namespace zero
 		zero::Command<double> m_magnitudeRangeMax{ 1.0 };
 		zero::Command<int> m_minConsecutiveSamples{ 0 };
 		zero::Command<double> m_monoAnalysisThreshold{ 0.99 };
+		zero::Command<int> m_analyses{ 0 };
+		zero::Command<int> m_loopWindowSize{ 1024 };
+		zero::Command<double> m_minGapMilliseconds{ 500.0 };
+		zero::Command<std::optional<int>> m_profile{ std::nullopt };
+		zero::Command<juce::String> m_alignPattern{ "folder" };
+		zero::Command<juce::String> m_fingerprintIndex{};
+		zero::Command<std::optional<juce::String>> m_pyramidDirectory{ std::nullopt };
+		zero::Command<std::optional<int>> m_watchSettleMilliseconds{ std::nullopt };
+		zero::Command<std::optional<juce::String>> m_serveSocket{ std::nullopt };
+		zero::Command<std::optional<std::pair<int, int>>> m_shard{ std::nullopt };
+		zero::Command<bool> m_merge{ false };
+		zero::Command<std::vector<double>> m_sweepMinimums{};
+		zero::Command<std::vector<int>> m_sweepConsecutiveSamples{};
+		zero::Command<double> m_loudnessTarget{ -23.0 };
+		zero::Command<std::optional<juce::int64>> m_maxMemoryBytes{ std::nullopt };
 
 		int m_numMonoFiles{ 0 };
+		int m_numClickyLoops{ 0 };
+		int m_numSegmentedFiles{ 0 };
+		int m_numAlignmentGroups{ 0 };
+		int m_numMisalignedFiles{ 0 };
+		int m_numDuplicateFiles{ 0 };
+		std::atomic<int> m_numReusedFingerprints{ 0 };
+		std::atomic<int> m_numReusedPyramids{ 0 };
 		juce::int64 m_sizeSavingsBytes{ 0 };
 
 	private:
 		std::unique_ptr<Console> m_console{ nullptr };
+		std::unique_ptr<MemoryBudget> m_memoryBudget{ nullptr };
+		std::unique_ptr<BlockPrefetcher> m_prefetcher{ nullptr };
 
 		juce::AudioFormatManager m_formatMngr{};
 	};